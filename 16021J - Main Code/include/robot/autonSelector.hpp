@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+#include "liblvgl/lvgl.h"
+#include "pros/rtos.hpp"
+#include "lemlib/asset.hpp"
+#include "lemlib/pose.hpp"
+#include "robot/chassis.hpp"
+#include "robot/path.hpp"
+
+namespace robot {
+
+/**
+ * @brief An autonomous routine. Gets the paths it was registered with, already parsed, in the same order
+ */
+using Routine = std::function<void(const std::vector<Path>& paths)>;
+
+/**
+ * @brief Brain screen selector for autonomous routines
+ *
+ * Every routine is registered with its start pose and the path assets it follows. Selecting a routine does all
+ * of its setup right away, while the robot is still disabled: its paths are parsed into robot::Path objects
+ * and the pose of the chassis is set to its start pose. autonomous() then only has to call run(), so no part of
+ * the 15 seconds is spent parsing paths.
+ *
+ * The selector is an LVGL dropdown, so a routine is selected from the LVGL task. Once run() is called the
+ * selection is locked until the program restarts, so a stray tap can't change the paths out from under the
+ * routine.
+ */
+class AutonSelector {
+    public:
+        /**
+         * @brief Create a new autonomous selector
+         *
+         * @param chassis the chassis, to set the start pose of the selected routine
+         *
+         * @b Example
+         * @code {.cpp}
+         * ASSET(first_txt);
+         * ASSET(second_txt);
+         * robot::AutonSelector auton_selector(chassis);
+         *
+         * void initialize() {
+         *     auton_selector.add("Two rings", {-55.5, 12, 270}, [](const std::vector<robot::Path>& paths) {
+         *         chassis.follow(paths[0], 3000);
+         *         chassis.follow(paths[1], 3000);
+         *     }, {&first_txt, &second_txt});
+         *     auton_selector.select(0);
+         *     auton_selector.create(lv_scr_act(), 260, 190);
+         * }
+         *
+         * void autonomous() {
+         *     auton_selector.run();
+         * }
+         * @endcode
+         */
+        AutonSelector(Chassis& chassis);
+        /**
+         * @brief Register a routine. Has to be called before create()
+         *
+         * @param name the name shown in the selector
+         * @param start the start pose of the routine, theta in degrees
+         * @param routine the routine
+         * @param paths the path assets the routine follows. The assets have to stay alive, like ones made with
+         * ASSET()
+         * @return size_t the index of the routine
+         */
+        size_t add(const char* name, lemlib::Pose start, Routine routine,
+                   std::initializer_list<const asset*> paths = {});
+        /**
+         * @brief Create the dropdown
+         *
+         * @param parent the object to create the dropdown in
+         * @param x x position in the parent, in pixels
+         * @param y y position in the parent, in pixels
+         * @param width width of the dropdown, in pixels. 200 by default
+         */
+        void create(lv_obj_t* parent, lv_coord_t x, lv_coord_t y, lv_coord_t width = 200);
+        /**
+         * @brief Select a routine, parse its paths and set the start pose
+         *
+         * @param index the index of the routine
+         * @return true the routine was selected and is ready to run
+         * @return false the index is invalid, or run() was already called
+         */
+        bool select(size_t index);
+        /**
+         * @brief Get the index of the selected routine
+         *
+         * @return int -1 if no routine was selected
+         */
+        int getSelected() const;
+        /**
+         * @brief Run the selected routine, and lock the selection
+         *
+         * The start pose is set again first, since odometry tracks the robot being moved into place by hand.
+         * Does nothing if no routine was selected
+         */
+        void run();
+    private:
+        struct Entry {
+                const char* name;
+                lemlib::Pose start;
+                Routine routine;
+                std::vector<const asset*> assets;
+        };
+
+        Chassis& chassis;
+        std::vector<Entry> entries;
+        lv_obj_t* dropdown = nullptr;
+
+        // held while the selected routine is prepared, so run() can't start a half prepared routine
+        pros::Mutex mutex;
+        std::vector<Path> paths;
+        std::atomic<int> selected = -1;
+        std::atomic<bool> locked = false;
+};
+} // namespace robot
@@ -0,0 +1,718 @@
+#pragma once
+
+#include <atomic>
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "robot/contactDetector.hpp"
+#include "robot/fit.hpp"
+#include "robot/marker.hpp"
+#include "robot/path.hpp"
+#include "robot/pid.hpp"
+#include "robot/seqlock.hpp"
+#include "robot/tuningLog.hpp"
+
+namespace robot {
+
+/**
+ * @brief Parameters for Chassis::follow
+ *
+ * The lookahead distance is recalculated every tick:
+ * lookahead = (minLookahead + lookaheadSpeedGain * speed) / (1 + lookaheadCurvatureGain * curvature)
+ * where speed is the measured speed of the robot and curvature is the sharpest curvature of the
+ * path within that lookahead. The result is clamped to [minLookahead, maxLookahead]. This lets the
+ * robot look far ahead on straights and fast sections, and cut fewer corners on tight turns.
+ */
+struct FollowParams {
+        /** whether the robot should follow the path going forwards. True by default */
+        bool forwards = true;
+        /** the smallest lookahead distance, in inches. 8 by default */
+        float minLookahead = 8;
+        /** the largest lookahead distance, in inches. 20 by default */
+        float maxLookahead = 20;
+        /** how much the lookahead grows with speed, in inches per inch/second. 0.2 by default */
+        float lookaheadSpeedGain = 0.2;
+        /** how much the lookahead shrinks with path curvature, in inches. 10 by default */
+        float lookaheadCurvatureGain = 10;
+        /** distance before the end of the path where the movement will exit, without stopping the drivetrain.
+         * This lets the next queued motion start before the path ends. 0 by default */
+        float earlyExitRange = 0;
+};
+
+/**
+ * @brief Parameters for Chassis::boomerang
+ *
+ * We use a struct to simplify customization. Chassis::boomerang has many
+ * parameters and specifying them all just to set one optional param ruins
+ * readability. By passing a struct to the function, we can have named
+ * parameters, overcoming the c/c++ limitation
+ */
+struct BoomerangParams {
+        /** whether the robot should move forwards or backwards. True by default */
+        bool forwards = true;
+        /** carrot point multiplier. value between 0 and 1. Higher values result in curvier movements. 0.6 by default */
+        float lead = 0.6;
+        /** how fast the robot will move around corners. Recommended value 2-15. 0 means use horizontalDrift set in
+         * chassis class. 0 by default. */
+        float horizontalDrift = 0;
+        /** the maximum speed the robot can travel at. Value between 0-127. 127 by default */
+        float maxSpeed = 127;
+        /** the speed the robot is still moving at when it reaches the target. Value between 0-127. 0 by default */
+        float minSpeed = 0;
+        /** maximum acceleration and deceleration used to plan the speed along the path, in inches per second squared.
+         * 80 by default */
+        float maxAccel = 80;
+        /** distance before the target where the movement will exit, without stopping the drivetrain. 0 by default */
+        float earlyExitRange = 0;
+};
+
+/**
+ * @brief The result of Chassis::calibrateTrackingWheels
+ */
+struct TrackingWheelCalibration {
+        TrackingWheelFit vertical;
+        TrackingWheelFit horizontal;
+};
+
+/**
+ * @brief The result of Chassis::characterizeDrivetrain
+ */
+struct DrivetrainCharacterization {
+        /** effective track width, in inches. Usually larger than the measured one, because the wheels scrub */
+        float trackWidth = 0;
+        /** how well the spins fit a straight line, from 0 to 1 */
+        float trackWidthRSquared = 0;
+        /** error of the fitted track width on a separate spin in the other direction, as a fraction */
+        float trackWidthError = 0;
+        /** effective wheel diameter, in inches. 0 if there is no vertical tracking wheel to measure it against */
+        float wheelDiameter = 0;
+        /** how well the forward drive fit a straight line, from 0 to 1 */
+        float wheelDiameterRSquared = 0;
+        /** error of the fitted diameter when driving back, as a fraction */
+        float wheelDiameterError = 0;
+        /** the largest horizontal drift measured without the robot sliding sideways. In LemLib's units, with the
+         * speed as motor power from 0 to 127, so it can be passed straight to lemlib::Drivetrain */
+        float horizontalDrift = 0;
+        /** true if the robot slid at the fastest arc, so the drift is the real limit. False if the robot never
+         * slid, so the real limit is higher than horizontalDrift */
+        bool driftLimitFound = false;
+};
+
+/**
+ * @brief LemLib chassis with extra motion algorithms
+ *
+ * All of the LemLib motions are still available. Motions added here use the same motion "queue",
+ * so they can be mixed freely with the LemLib ones, and waitUntil() / waitUntilDone() work on them
+ */
+class Chassis : public lemlib::Chassis {
+    public:
+        using lemlib::Chassis::Chassis;
+        using lemlib::Chassis::follow;
+        /**
+         * @brief Calibrate the chassis sensors in the background
+         *
+         * Does the same work as lemlib::Chassis::calibrate, but returns immediately. The tracking wheels are
+         * reset right away, the IMU calibrates in a background task, and odometry starts as soon as the IMU is
+         * ready (or has failed 5 times, in which case odometry falls back to the tracking wheels). The LCD,
+         * other tasks and competition_initialize can run in the meantime. The pose can be set before
+         * calibration is done. Wait for isCalibrated() before starting a motion
+         *
+         * @param calibrateIMU whether the IMU should be calibrated. true by default
+         * @param odomPeriod time between odometry updates, in milliseconds, see robot::startOdom. 10 by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     chassis.calibrateAsync();
+         *     chassis.setPose(-55.5, 12, 270);
+         * }
+         *
+         * void autonomous() {
+         *     chassis.waitUntilCalibrated();
+         *     chassis.moveToPoint(-24, 24, 2000);
+         * }
+         * @endcode
+         */
+        void calibrateAsync(bool calibrateIMU = true, int odomPeriod = 10);
+        /**
+         * @brief Calibrate the chassis sensors, and wait until odometry is running
+         *
+         * Hides lemlib::Chassis::calibrate, which starts LemLib's own odometry task. That task never publishes the
+         * pose to robot::getPose, so the pose read by the motions would never change. This is calibrateAsync()
+         * followed by waitUntilCalibrated()
+         *
+         * @param calibrateIMU whether the IMU should be calibrated. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     chassis.calibrate();
+         * }
+         * @endcode
+         */
+        void calibrate(bool calibrateIMU = true);
+        /**
+         * @brief Set the pose of the chassis
+         *
+         * Same as lemlib::Chassis::setPose, but also publishes the pose to getPose(), see robot::setPose
+         *
+         * @param x new x value
+         * @param y new y value
+         * @param theta new theta value
+         * @param radians true if theta is in radians, false if not. False by default
+         */
+        void setPose(float x, float y, float theta, bool radians = false);
+        /**
+         * @brief Set the pose of the chassis
+         *
+         * @param pose the new pose
+         * @param radians whether pose theta is in radians (true) or not (false). false by default
+         */
+        void setPose(lemlib::Pose pose, bool radians = false);
+        /**
+         * @brief Get the pose of the chassis
+         *
+         * Reads the snapshot published by the odometry task, so it never blocks odometry, and x, y and theta
+         * always come from the same update. Read it once and keep the result rather than calling it for each
+         * field, see robot::getPose
+         *
+         * @param radians whether theta should be in radians (true) or degrees (false). false by default
+         * @param standardPos whether theta should be in standard form (0 is +x, counterclockwise is positive).
+         * false by default
+         * @return lemlib::Pose
+         *
+         * @b Example
+         * @code {.cpp}
+         * const lemlib::Pose pose = chassis.getPose();
+         * pros::lcd::print(0, "x: %.2f y: %.2f theta: %.2f", pose.x, pose.y, pose.theta);
+         * @endcode
+         */
+        lemlib::Pose getPose(bool radians = false, bool standardPos = false);
+        /**
+         * @brief Whether calibration started by calibrateAsync() is done and odometry is running
+         *
+         * @return true the pose is usable
+         * @return false calibration is still running, or hasn't been started
+         */
+        bool isCalibrated() const;
+        /**
+         * @brief Wait until calibration started by calibrateAsync() is done
+         *
+         * @param timeout longest time to wait, in milliseconds. Waits forever by default
+         * @return true the pose is usable
+         * @return false the timeout ran out first
+         */
+        bool waitUntilCalibrated(int timeout = -1) const;
+        /**
+         * @brief Get how long it took from the program starting to the pose being usable
+         *
+         * @return int time in milliseconds. -1 if calibration isn't done
+         */
+        int getCalibrationTime() const;
+        /**
+         * @brief Move the chassis towards the target pose
+         *
+         * Uses the boomerang controller, ported from lemlib::Chassis::moveToPose. Unlike LemLib's, it reports its
+         * progress to getRemainingDistance() and getMotionETA(), can run markers, and leaves the drivetrain
+         * running when it exits early to chain into the next motion (params.minSpeed is not 0 and the robot
+         * passed the target, see params.earlyExitRange). It stops the drivetrain on any other exit
+         *
+         * @param x x location
+         * @param y y location
+         * @param theta target heading in degrees.
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // move the robot to x = 20, y = 15, and face heading 90 with a timeout of 4000ms
+         * chassis.moveToPose(20, 15, 90, 4000);
+         * // but face the point with the back of the robot
+         * chassis.moveToPose(20, 15, 90, 4000, {.forwards = false});
+         * @endcode
+         */
+        void moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params = {},
+                        bool async = true);
+        /**
+         * @brief Move the chassis towards the target pose, running actions along the way
+         *
+         * @param x x location
+         * @param y y location
+         * @param theta target heading in degrees.
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param markers actions to run during the motion, see robot::Marker
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // lower the intake halfway to the target
+         * chassis.moveToPose(20, 15, 90, 4000, {},
+         *                    {robot::Marker::atFraction(0.5, [] { intake_piston.set_value(1); })});
+         * @endcode
+         */
+        void moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params, Markers markers,
+                        bool async = true);
+        /**
+         * @brief Move the chassis towards a target point
+         *
+         * Ported from lemlib::Chassis::moveToPoint. Unlike LemLib's, it reports its progress to
+         * getRemainingDistance() and getMotionETA(), can run markers, and leaves the drivetrain running when it
+         * exits early to chain into the next motion (params.minSpeed is not 0 and the robot passed the target, see
+         * params.earlyExitRange). It stops the drivetrain on any other exit
+         *
+         * @param x x location
+         * @param y y location
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // move the robot to x = 20, y = 15 with a timeout of 4000ms
+         * chassis.moveToPoint(20, 15, 4000);
+         * // move the robot to x = 20, y = 15 with a timeout of 4000ms, driving backwards
+         * chassis.moveToPoint(20, 15, 4000, {.forwards = false});
+         * @endcode
+         */
+        void moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params = {}, bool async = true);
+        /**
+         * @brief Move the chassis towards a target point, running actions along the way
+         *
+         * @param x x location
+         * @param y y location
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param markers actions to run during the motion, see robot::Marker
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // back into the stake, and clamp it 150ms before the robot gets there
+         * chassis.moveToPoint(-24, 24, 2000, {.forwards = false},
+         *                     {robot::Marker::beforeEnd(150, [] { stake_lock.set_value(1); })});
+         * @endcode
+         */
+        void moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params, Markers markers,
+                         bool async = true);
+        /**
+         * @brief Turn the chassis so it is facing the target heading
+         *
+         * Same as lemlib::Chassis::turnToHeading, but uses the angular controller that can be changed with
+         * setAngularGains, and records to the tuning log
+         *
+         * @param theta heading location
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // turn the robot to face heading 135, with a timeout of 1000ms
+         * chassis.turnToHeading(135, 1000);
+         * // turn the robot to face heading 90, counterclockwise, with a maximum speed of 60
+         * chassis.turnToHeading(90, 1500, {.direction = lemlib::AngularDirection::CCW_COUNTERCLOCKWISE,
+         *                                 .maxSpeed = 60});
+         * @endcode
+         */
+        void turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params = {}, bool async = true);
+        /**
+         * @brief Follow a path with pure pursuit, using an adaptive lookahead
+         *
+         * Unlike lemlib::Chassis::follow, the distance reported to waitUntil() is the distance along
+         * the path rather than the distance driven, so waitUntil(24) returns when the robot is 24 inches
+         * into the path even if it had to correct sideways to get there
+         *
+         * @param path the path to follow. Has to stay alive until the motion is done
+         * @param timeout the maximum time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * ASSET(myPath_txt);
+         * robot::Path myPath(myPath_txt);
+         *
+         * void autonomous() {
+         *     // follow the path with the default lookahead settings
+         *     chassis.follow(myPath, 4000);
+         *     // start the intake 24 inches into the path
+         *     chassis.waitUntil(24);
+         *     intake.move(127);
+         *     // follow the path backwards, and exit 6 inches before the end so the next motion
+         *     // starts without the robot coming to a stop
+         *     chassis.follow(myPath, 4000, {.forwards = false, .earlyExitRange = 6});
+         * }
+         * @endcode
+         */
+        void follow(const Path& path, int timeout, FollowParams params = {}, bool async = true);
+        /**
+         * @brief Follow a path with pure pursuit, running actions along the way
+         *
+         * @param path the path to follow. Has to stay alive until the motion is done
+         * @param timeout the maximum time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param markers actions to run during the motion, see robot::Marker. Distances are along the path
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // start the intake as the robot enters the corner, and stop it 24 inches later
+         * chassis.follow(myPath, 4000, {},
+         *                {robot::Marker::inRegion(-60, -60, 12, [] { intake.move(127); }),
+         *                 robot::Marker::atDistance(96, [] { intake.brake(); })});
+         * @endcode
+         */
+        void follow(const Path& path, int timeout, FollowParams params, Markers markers, bool async = true);
+        /**
+         * @brief Follow a path asset with pure pursuit, using an adaptive lookahead
+         *
+         * The asset is parsed every time this is called. Parse it into a robot::Path ahead of time
+         * to avoid that cost
+         *
+         * @param path the path asset to follow
+         * @param timeout the maximum time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * ASSET(myPath_txt);
+         *
+         * void autonomous() {
+         *     chassis.follow(myPath_txt, 4000, {.minLookahead = 6, .maxLookahead = 15});
+         * }
+         * @endcode
+         */
+        void follow(const asset& path, int timeout, FollowParams params = {}, bool async = true);
+        /**
+         * @brief Move the chassis to a pose along a boomerang path that is solved once, at the start of the motion
+         *
+         * lemlib::Chassis::moveToPose recalculates the carrot point every tick, so its path (and how long it takes)
+         * is only known once the motion is over. This motion solves the boomerang curve from the current pose to the
+         * target into a short spline, plans a speed profile along it, and tracks it with pure pursuit. The work done
+         * every tick is bounded by the fixed number of points in the spline, and the time the motion should take is
+         * known as soon as it starts, see getPredictedEndTime()
+         *
+         * @param x x location
+         * @param y y location
+         * @param theta target heading in degrees.
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // move the robot to x = 20, y = 15, and face heading 90 with a timeout of 4000ms
+         * chassis.boomerang(20, 15, 90, 4000);
+         * // back into the stake, accelerating gently
+         * chassis.boomerang(-24, 24, 300, 2000, {.forwards = false, .maxAccel = 40});
+         * @endcode
+         */
+        void boomerang(float x, float y, float theta, int timeout, BoomerangParams params = {}, bool async = true);
+        /**
+         * @brief Move the chassis to a pose along a solved boomerang path, running actions along the way
+         *
+         * @param x x location
+         * @param y y location
+         * @param theta target heading in degrees.
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param markers actions to run during the motion, see robot::Marker. Distances are along the path
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.boomerang(-24, 24, 300, 2000, {.forwards = false},
+         *                   {robot::Marker::beforeEnd(100, [] { stake_lock.set_value(1); })});
+         * @endcode
+         */
+        void boomerang(float x, float y, float theta, int timeout, BoomerangParams params, Markers markers,
+                       bool async = true);
+        /**
+         * @brief Measure the offsets of the tracking wheels by spinning in place
+         *
+         * When the robot turns in place, a tracking wheel travels its offset times the angle turned. The robot
+         * turns 90 degrees at a time with turnToHeading, alternating direction every revolution, and records
+         * the IMU rotation and the distance of each tracking wheel once it settles. The offset is the slope of
+         * the least squares line through those samples.
+         *
+         * Spinning can only measure the offset relative to the wheel diameter. To measure the diameter as well,
+         * pass a pushDistance: after spinning, the routine asks for the robot to be pushed straight forward that
+         * far along the field tiles, then the same distance to the right, and scales the results by how far each
+         * wheel thought it went.
+         *
+         * The results and the matching lemlib::TrackingWheel constructor arguments are printed to the terminal.
+         * The IMU has to be calibrated, and the robot needs about 3 feet of free space around it.
+         *
+         * @param spins how many full revolutions to spin. 5 by default
+         * @param pushDistance how far the robot will be pushed to measure the wheel diameters, in inches. 0
+         * (don't measure them) by default
+         * @return TrackingWheelCalibration the fitted offsets and diameters
+         *
+         * @b Example
+         * @code {.cpp}
+         * void autonomous() {
+         *     chassis.waitUntilCalibrated();
+         *     // spin 5 times, then measure the diameters by pushing the robot 2 tiles each way
+         *     chassis.calibrateTrackingWheels(5, 48);
+         * }
+         * @endcode
+         */
+        TrackingWheelCalibration calibrateTrackingWheels(int spins = 5, float pushDistance = 0);
+        /**
+         * @brief Measure the effective track width, wheel diameter and horizontal drift of the drivetrain
+         *
+         * The robot drives a set of patterns with open loop tank controls, so the results don't depend on the
+         * values being measured:
+         * - forwards and backwards: the distance from the drive motor encoders is fit against the vertical
+         *   tracking wheel for the wheel diameter. The backwards drive checks the fit
+         * - spinning clockwise in place: the difference between the left and right motor distances is fit
+         *   against the IMU rotation for the track width. A counterclockwise spin at a different speed checks it
+         * - arcs at increasing speeds: the sideways speed measured by odometry shows when the robot starts to
+         *   slide, and the fastest arc without sliding gives the horizontal drift. Like LemLib, the drift uses
+         *   the speed as motor power from 0 to 127, not inches per second
+         *
+         * A report and the matching lemlib::Drivetrain constructor arguments are printed to the terminal. Run
+         * calibrateTrackingWheels first, since the wheel diameter and drift are measured with the tracking
+         * wheels. The robot needs about 4 feet of free space in front and around it.
+         *
+         * @return DrivetrainCharacterization the fitted values and how much they can be trusted
+         *
+         * @b Example
+         * @code {.cpp}
+         * void autonomous() {
+         *     chassis.waitUntilCalibrated();
+         *     chassis.characterizeDrivetrain();
+         * }
+         * @endcode
+         */
+        DrivetrainCharacterization characterizeDrivetrain();
+        /**
+         * @brief Get the time the current path based motion is predicted to finish
+         *
+         * The prediction is made when the motion starts, from the speeds along its path
+         *
+         * @return uint32_t time, in milliseconds since the program started. 0 if no prediction is available
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.boomerang(20, 15, 90, 4000);
+         * pros::delay(10); // let the motion start
+         * printf("motion will take %d ms\n", chassis.getPredictedEndTime() - pros::millis());
+         * @endcode
+         */
+        uint32_t getPredictedEndTime() const;
+        /**
+         * @brief Drive with tank controls until the robot drives into something
+         *
+         * Contact is detected by a robot::ContactDetector on the drivetrain motors. The drivetrain keeps the given
+         * power when this function returns, so a clamp can close while the robot is still pressing against the
+         * object. Stop the drivetrain afterwards with tank(0, 0)
+         *
+         * @param left speed of the left side of the drivetrain. Takes an input from -127 to 127.
+         * @param right speed of the right side of the drivetrain. Takes an input from -127 to 127.
+         * @param timeout longest time the robot can spend driving
+         * @param settings contact detection thresholds
+         * @return true contact was detected
+         * @return false the timeout ran out first
+         *
+         * @b Example
+         * @code {.cpp}
+         * // back into the stake, and clamp it as soon as the robot hits it
+         * chassis.tankUntilContact(-127, -127, 300);
+         * stake_lock.set_value(1);
+         * pros::delay(150);
+         * chassis.tank(0, 0);
+         * @endcode
+         */
+        bool tankUntilContact(int left, int right, int timeout, ContactSettings settings = {});
+        /**
+         * @brief Get how far the robot still has to travel in the current motion
+         *
+         * For follow() and boomerang() this is the distance left along the path. For moveToPoint() and
+         * moveToPose() it is the straight line distance to the target
+         *
+         * @return float distance in inches. 0 if no motion is running, -1 if the current motion doesn't
+         * report its progress (turns and swings)
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.moveToPoint(20, 15, 4000);
+         * // wait until the robot is 10 inches away from the target
+         * while (chassis.getRemainingDistance() > 10) pros::delay(10);
+         * @endcode
+         */
+        float getRemainingDistance() const;
+        /**
+         * @brief Estimate how long the current motion will take to finish
+         *
+         * For follow() and boomerang() this is the time left in the speed plan of the path. For moveToPoint()
+         * and moveToPose() the remaining distance is divided by the current speed of the robot, from
+         * robot::getSpeed(). The speed is floored at a quarter of the top speed of the drivetrain, so a robot
+         * that is just starting to accelerate doesn't report an ETA of several seconds
+         *
+         * @return int time in milliseconds. 0 if no motion is running, -1 if the current motion doesn't report
+         * its progress (turns and swings)
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.moveToPoint(-24, 24, 2000);
+         * // start the intake 300ms before the robot arrives at the ring
+         * while (chassis.getMotionETA() > 300) pros::delay(10);
+         * intake.move(127);
+         * @endcode
+         */
+        int getMotionETA() const;
+        /**
+         * @brief Get the version of the path being tracked
+         *
+         * Cheap enough to call every frame, to know when copyActivePath() has to be called again
+         *
+         * @return int incremented every time a path based motion starts or ends
+         */
+        int getActivePathVersion() const;
+        /**
+         * @brief Copy the path being tracked by follow() or boomerang()
+         *
+         * @param points cleared and filled with the points of the path. Empty if no path is being tracked
+         * @return int the version of the copied path, see getActivePathVersion()
+         *
+         * @b Example
+         * @code {.cpp}
+         * std::vector<robot::PathPoint> points;
+         * int version = -1;
+         * while (true) {
+         *     if (chassis.getActivePathVersion() != version) version = chassis.copyActivePath(points);
+         *     pros::delay(100);
+         * }
+         * @endcode
+         */
+        int copyActivePath(std::vector<PathPoint>& points);
+        /**
+         * @brief Record the errors and outputs of the PID controllers every tick of moveToPoint and moveToPose
+         *
+         * Recording costs a few stores per tick. Samples are dropped when the log is full, so the motions never
+         * wait for whatever reads the log
+         *
+         * @param log the log to write to, nullptr to stop recording
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::TuningChart tuning_chart;
+         *
+         * void initialize() {
+         *     chassis.setTuningLog(tuning_chart.getLog());
+         *     tuning_chart.start();
+         * }
+         * @endcode
+         */
+        void setTuningLog(TuningLog* log);
+        /**
+         * @brief Get the log set with setTuningLog
+         *
+         * @return TuningLog* nullptr if nothing is being recorded
+         */
+        TuningLog* getTuningLog() const;
+        /**
+         * @brief Change the gains of the lateral controller while the program runs
+         *
+         * Used by moveToPoint and moveToPose. Takes effect on the next tick, even during a motion. LemLib's own
+         * motions keep the gains the chassis was created with
+         *
+         * @param gains the new gains
+         */
+        void setLateralGains(PIDGains gains);
+        /**
+         * @brief Change the gains of the angular controller while the program runs
+         *
+         * Used by moveToPoint, moveToPose and turnToHeading. Takes effect on the next tick, even during a motion.
+         * LemLib's own motions, like turnToPoint and swingToHeading, keep the gains the chassis was created with
+         *
+         * @param gains the new gains
+         */
+        void setAngularGains(PIDGains gains);
+        /**
+         * @brief Get the gains of the lateral controller
+         *
+         * @return PIDGains
+         */
+        PIDGains getLateralGains() const;
+        /**
+         * @brief Get the gains of the angular controller
+         *
+         * @return PIDGains
+         */
+        PIDGains getAngularGains() const;
+    protected:
+        /**
+         * @brief Track a path with pure pursuit. Used by all of the path based motions
+         *
+         * The motion must already be started with requestMotionStart(). It is ended by this function
+         *
+         * @param path the path to track
+         * @param timeout longest time the robot can spend moving
+         * @param params tracking parameters
+         * @param markers actions to run during the motion
+         */
+        void track(const Path& path, int timeout, FollowParams params, Markers& markers);
+        /**
+         * @brief Get the top speed of the drivetrain
+         *
+         * @return float speed in inches per second
+         */
+        float maxVelocity() const;
+
+        /**
+         * @brief Publish the progress of the current motion, for getRemainingDistance() and getMotionETA()
+         *
+         * @param distance distance left to travel, in inches
+         * @param plannedTime time left according to the speed plan of the motion, in seconds. -1 if the
+         * motion has no speed plan
+         */
+        void setProgress(float distance, float plannedTime = -1);
+        /**
+         * @brief Clear the progress of the current motion. Called when a motion ends
+         */
+        void clearProgress();
+        /**
+         * @brief Publish the path being tracked, for copyActivePath()
+         *
+         * @param path the path, which has to stay alive until this is called again. nullptr when the motion ends
+         */
+        void setActivePath(const Path* path);
+        /**
+         * @brief Add a sample to the tuning log, if there is one
+         *
+         * @param lateralError error of the lateral controller, in inches
+         * @param lateralOutput output of the lateral controller
+         * @param angularError error of the angular controller, in degrees
+         * @param angularOutput output of the angular controller
+         */
+        void recordTuning(float lateralError, float lateralOutput, float angularError, float angularOutput);
+
+        // hide the lemlib::PID controllers, which have const gains, so the gains can be changed at runtime
+        PID lateralPID {lateralSettings.kP, lateralSettings.kI, lateralSettings.kD, lateralSettings.windupRange, true};
+        PID angularPID {angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange, true};
+
+        pros::Task* calibrationTask = nullptr;
+        std::atomic<bool> calibrated = false;
+        int calibrationTime = -1;
+
+        // written by the motion task, read by any task
+        struct Progress {
+                float remainingDistance = 0;
+                float plannedTimeLeft = -1;
+                std::uint32_t known = false;
+        };
+
+        std::atomic<uint32_t> predictedEnd = 0;
+        Seqlock<Progress> progress;
+
+        // only held while the active path changes or is copied, never while it is tracked
+        pros::Mutex activePathMutex;
+        const Path* activePath = nullptr;
+        std::atomic<int> activePathVersion = 0;
+        std::atomic<TuningLog*> tuningLog = nullptr;
+};
+} // namespace robot
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include "pros/motor_group.hpp"
+
+namespace robot {
+
+/**
+ * @brief Thresholds used by ContactDetector
+ *
+ * The defaults are a good starting point for a 360rpm blue motor drivetrain. To tune, print the
+ * current draw and velocity of the drive motors while ramming a stake and while driving freely
+ */
+struct ContactSettings {
+        /** average current draw of the drive motors above which they may be stalled, in mA. 1800 by default */
+        float current = 1800;
+        /** fraction of the peak speed the robot has to drop below to count as stopped. 0.35 by default */
+        float speedRatio = 0.35;
+        /** time after the start where nothing is detected, since motors draw a lot of current while they
+         * accelerate, in ms. 120 by default */
+        int ignoreTime = 120;
+        /** how long the contact has to last before it is reported, in ms. 30 by default */
+        int confirmTime = 30;
+};
+
+/**
+ * @brief Detects when the robot drives into something and stops
+ *
+ * A robot that hits an object, like a mobile goal, keeps drawing a lot of current while its wheels and its
+ * tracked position slow down. This class watches the current draw and velocity of the drive motors, and the
+ * speed reported by odometry, and reports contact once the motors are drawing more than the current threshold
+ * while either the motors or odometry have slowed down well below the peak speed seen so far.
+ *
+ * It has the same interface as lemlib::ExitCondition, so it can end a motion the same way
+ */
+class ContactDetector {
+    public:
+        /**
+         * @brief Create a new contact detector
+         *
+         * @param leftMotors the left motors of the drivetrain
+         * @param rightMotors the right motors of the drivetrain
+         * @param settings detection thresholds
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::ContactDetector contact(&left_motor_group, &right_motor_group, {.current = 2000});
+         * @endcode
+         */
+        ContactDetector(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, ContactSettings settings = {});
+        /**
+         * @brief whether contact has been detected
+         *
+         * @return true contact detected
+         * @return false no contact detected
+         */
+        bool getExit();
+        /**
+         * @brief update the detector. Should be called every 10ms while driving
+         *
+         * The first update after a reset starts the ignore time
+         *
+         * @return true contact detected
+         * @return false no contact detected
+         */
+        bool update();
+        /**
+         * @brief reset the detector so it can be used for another maneuver
+         */
+        void reset();
+    private:
+        pros::MotorGroup* leftMotors;
+        pros::MotorGroup* rightMotors;
+        const ContactSettings settings;
+        int startTime = -1;
+        int contactTime = -1;
+        float peakMotorSpeed = 0;
+        float peakOdomSpeed = 0;
+        bool done = false;
+};
+} // namespace robot
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+
+namespace robot {
+
+/**
+ * @brief Keeps the controller screen up to date without making anything wait for it
+ *
+ * The controller only accepts a new screen update or rumble every 50ms, and the radio is slow, so printing to
+ * it directly from opcontrol() either stalls the loop or drops text. Instead, tasks set the text they want on
+ * each of the 3 lines, which only copies it, and a low priority task sends it. Every 50ms the task compares
+ * what each line should show with what was last sent, and sends only the characters that changed, one line
+ * per update. If the controller disconnects, everything is sent again once it's back.
+ *
+ * Alerts temporarily replace the last line, and can rumble the controller.
+ */
+class ControllerDisplay {
+    public:
+        /**
+         * @brief Create a new controller display
+         *
+         * @param controller the controller
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Controller controller(pros::E_CONTROLLER_MASTER);
+         * robot::ControllerDisplay controller_display(controller);
+         *
+         * void initialize() {
+         *     controller_display.start();
+         * }
+         *
+         * void opcontrol() {
+         *     controller_display.setLine(0, "Battery: %.0f%%", pros::battery::get_capacity());
+         *     controller_display.alert("Motor hot", 2000, "-");
+         * }
+         * @endcode
+         */
+        ControllerDisplay(pros::Controller& controller);
+        /**
+         * @brief Start sending updates to the controller in a low priority task
+         */
+        void start();
+        /**
+         * @brief Set the text of a line. Never waits for the controller
+         *
+         * @param line the line, from 0 to 2
+         * @param fmt printf style format string. Text longer than LINE_WIDTH is cut off
+         * @param ... format arguments
+         */
+        void setLine(std::uint8_t line, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+        /**
+         * @brief Show an alert on the last line for a while. Never waits for the controller
+         *
+         * A new alert replaces the one being shown
+         *
+         * @param text the text of the alert. Text longer than LINE_WIDTH is cut off
+         * @param duration how long to show the alert, in milliseconds
+         * @param rumble rumble pattern to play, like "-." or "...", nullptr for none
+         */
+        void alert(const char* text, int duration = 2000, const char* rumble = nullptr);
+        /** the number of lines of the controller screen */
+        static constexpr size_t LINES = 3;
+        /** the number of characters in a line */
+        static constexpr size_t LINE_WIDTH = 15;
+        /** the controller accepts one update in this many milliseconds */
+        static constexpr int UPDATE_PERIOD = 50;
+    private:
+        using Line = std::array<char, LINE_WIDTH + 1>;
+
+        void update();
+        static void copyPadded(Line& line, const char* text);
+
+        pros::Controller& controller;
+        pros::Task* task = nullptr;
+
+        // held while the text is copied, never while talking to the controller
+        pros::Mutex mutex;
+        std::array<Line, LINES> wanted {};
+        Line alertText {};
+        std::uint32_t alertUntil = 0;
+        std::array<char, 9> rumblePattern {};
+
+        // only used by the task
+        std::array<Line, LINES> sent {};
+        size_t nextLine = 0;
+        bool connected = false;
+};
+} // namespace robot
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include "pros/misc.hpp"
+#include "robot/seqlock.hpp"
+
+namespace robot {
+
+/**
+ * @brief Positions of the controller sticks, from -127 to 127
+ */
+struct Sticks {
+        int leftX = 0;
+        int leftY = 0;
+        int rightX = 0;
+        int rightY = 0;
+};
+
+/**
+ * @brief Latency measured by ControllerSync, over the last report period
+ */
+struct DriverLatency {
+        /** number of times the sticks changed, which is a new packet from the controller */
+        std::uint32_t changes = 0;
+        /** average time from the change arriving to the motors being commanded, in milliseconds. The change is
+         * assumed to arrive halfway between the tick that saw it and the tick before */
+        float meanLatency = 0;
+        /** longest time from the tick before a change to the motors being commanded, in milliseconds. The
+         * latency is never more than this */
+        float maxLatency = 0;
+        /** average time between changes while the sticks keep moving, in milliseconds. Close to the time between
+         * controller packets */
+        float packetInterval = 0;
+        /** number of ticks that started more than a millisecond late */
+        std::uint32_t overruns = 0;
+};
+
+/**
+ * @brief Runs the driver control loop faster than the controller sends packets, and measures the latency
+ *
+ * The controller sends the stick positions on its own schedule, so a slow loop either drives with old positions
+ * or adds up to a whole loop of latency. wait() wakes up every period with pros::Task::delay_until, reads the
+ * sticks, and returns true when they changed, so new positions reach the motors within one period of arriving.
+ * PROS doesn't say when a packet arrived, so a packet with the same positions as the last one can't be seen,
+ * which doesn't matter because there's nothing new to apply.
+ *
+ * Call applied() right after commanding the motors. Every report period the latency is sent to
+ * lemlib::telemetrySink() as `driver,<changes>,<mean latency>,<max latency>,<packet interval>,<overruns>`. The
+ * latency doesn't include the few milliseconds until the brain sends the command to the motors.
+ *
+ * wait(), getSticks() and applied() must be called from the same task, getLatency() can be called from any task.
+ */
+class ControllerSync {
+    public:
+        /**
+         * @brief Create a new controller sync
+         *
+         * @param controller the controller to read
+         * @param period time between ticks, in milliseconds. 10 by default
+         * @param reportPeriod time between latency reports, in milliseconds. 1000 by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::ControllerSync controller_sync(controller);
+         *
+         * void opcontrol() {
+         *     while (true) {
+         *         controller_sync.wait();
+         *         const robot::Sticks sticks = controller_sync.getSticks();
+         *         chassis.arcade(sticks.leftY, sticks.rightX);
+         *         controller_sync.applied();
+         *     }
+         * }
+         * @endcode
+         */
+        ControllerSync(pros::Controller& controller, int period = 10, int reportPeriod = 1000);
+        /**
+         * @brief Wait for the next tick, then read the sticks
+         *
+         * @return true the sticks changed since the last tick
+         * @return false the sticks didn't change
+         */
+        bool wait();
+        /**
+         * @brief Get the stick positions read by the last wait()
+         *
+         * @return Sticks
+         */
+        Sticks getSticks() const;
+        /**
+         * @brief Record that the motors were just commanded with the sticks read by the last wait()
+         */
+        void applied();
+        /**
+         * @brief Get the latency of the last report period
+         *
+         * @return DriverLatency
+         */
+        DriverLatency getLatency() const;
+    private:
+        void report(std::uint32_t now);
+
+        pros::Controller& controller;
+        const int period;
+        const int reportPeriod;
+        Sticks sticks;
+
+        // only touched by the task calling wait() and applied()
+        std::uint32_t wakeTime = 0;
+        std::uint64_t tickTime = 0;
+        std::uint64_t previousTickTime = 0;
+        std::uint64_t lastChangeTime = 0;
+        bool measure = false;
+        bool running = false;
+        std::uint32_t changes = 0;
+        std::uint64_t totalLatency = 0;
+        std::uint64_t maxLatency = 0;
+        std::uint32_t intervals = 0;
+        std::uint64_t totalInterval = 0;
+        std::uint32_t overruns = 0;
+        std::uint32_t lastReport = 0;
+
+        Seqlock<DriverLatency> latency;
+};
+} // namespace robot
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "liblvgl/lvgl.h"
+#include "pros/motor_group.hpp"
+#include "robot/chassis.hpp"
+#include "robot/fieldView.hpp"
+
+namespace robot {
+
+/**
+ * @brief Settings for Dashboard
+ */
+struct DashboardSettings {
+        /** time between updates, in milliseconds. 100 by default */
+        int period = 100;
+        /** size of the robot, trail settings and side length of the field map. The map is 200 pixels by
+         * default */
+        FieldViewSettings field = {};
+        /** updates that take longer than this are counted in Dashboard::getOverBudgetCount, in microseconds. 2000
+         * by default */
+        int budget = 2000;
+};
+
+/**
+ * @brief LVGL dashboard for the brain screen
+ *
+ * Shows a FieldView map of the field, the pose, the battery, the calibration status and the temperature of each
+ * motor group. Unlike printing every line with pros::lcd, the values are rounded to what is
+ * shown and a widget is only changed when its value changes, so LVGL only redraws the parts of the screen that
+ * changed, merged into as few areas as possible.
+ *
+ * The update runs in an LVGL timer, in the same task that draws the screen, so widgets are never changed while
+ * they are drawn. The pose is read with robot::getPose, which never blocks odometry.
+ */
+class Dashboard {
+    public:
+        /**
+         * @brief Create a new dashboard
+         *
+         * @param chassis the chassis, for its calibration status
+         * @param settings update rate, field map settings and CPU budget
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::Dashboard dashboard(chassis);
+         *
+         * void initialize() {
+         *     dashboard.addMotors("Left", &left_motor_group);
+         *     dashboard.addMotors("Right", &right_motor_group);
+         *     dashboard.start();
+         * }
+         * @endcode
+         */
+        Dashboard(Chassis& chassis, DashboardSettings settings = {});
+        /**
+         * @brief Show the hottest temperature of a motor group
+         *
+         * @param name the name shown next to the temperature
+         * @param motors the motor group
+         * @return true the group was added
+         * @return false there are already MAX_MOTOR_GROUPS groups
+         */
+        bool addMotors(const char* name, pros::MotorGroup* motors);
+        /**
+         * @brief Create the widgets, load the dashboard screen and start updating it
+         */
+        void start();
+        /**
+         * @brief Get how long the last update took, not including LVGL drawing it
+         *
+         * @return std::uint32_t time in microseconds
+         */
+        std::uint32_t getUpdateTime() const;
+        /**
+         * @brief Get how many updates took longer than the budget
+         *
+         * @return int
+         */
+        int getOverBudgetCount() const;
+        /**
+         * @brief Get the screen the dashboard draws on
+         *
+         * @return lv_obj_t* the screen, nullptr before start() is called
+         */
+        lv_obj_t* getScreen() const;
+        /** the maximum number of motor groups */
+        static constexpr size_t MAX_MOTOR_GROUPS = 4;
+    private:
+        struct MotorRow {
+                const char* name = nullptr;
+                pros::MotorGroup* motors = nullptr;
+                lv_obj_t* label = nullptr;
+                int temperature = -1;
+        };
+
+        void update();
+        lv_obj_t* createLabel(lv_coord_t x, lv_coord_t y);
+
+        Chassis& chassis;
+        const DashboardSettings settings;
+        std::array<MotorRow, MAX_MOTOR_GROUPS> motorRows {};
+        size_t motorCount = 0;
+
+        lv_obj_t* screen = nullptr;
+        FieldView field;
+        lv_obj_t* poseLabel = nullptr;
+        lv_obj_t* batteryLabel = nullptr;
+        lv_obj_t* statusLabel = nullptr;
+        lv_timer_t* timer = nullptr;
+
+        // the last values shown, in the units they are shown in
+        int x = INT32_MIN;
+        int y = INT32_MIN;
+        int theta = INT32_MIN;
+        int battery = -1;
+        int calibrationTime = -1;
+
+        std::uint32_t updateTime = 0;
+        int overBudgetCount = 0;
+};
+} // namespace robot
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include "liblvgl/lvgl.h"
+#include "robot/seqlock.hpp"
+
+namespace robot {
+
+/**
+ * @brief Limits for DisplayMonitor. Going over one is counted and reported
+ */
+struct DisplayBudget {
+        /** longest a single refresh of the screen can take, in milliseconds. 10 by default */
+        std::uint32_t refreshTime = 10;
+        /** largest fraction of the time LVGL can spend drawing, from 0 to 1. 0.05 by default */
+        float cpuShare = 0.05;
+        /** largest fraction of the LVGL heap that can be used, from 0 to 1. 0.75 by default */
+        float memoryUsed = 0.75;
+        /** time between reports, in milliseconds. 1000 by default */
+        std::uint32_t reportPeriod = 1000;
+};
+
+/**
+ * @brief Statistics measured by DisplayMonitor, over the last report period unless noted
+ */
+struct DisplayStats {
+        /** number of times the screen was redrawn */
+        std::uint32_t refreshes = 0;
+        /** average time a refresh took, in milliseconds */
+        float refreshTime = 0;
+        /** longest time a refresh took, in milliseconds */
+        std::uint32_t maxRefreshTime = 0;
+        /** average number of pixels redrawn per refresh */
+        std::uint32_t pixels = 0;
+        /** fraction of the time spent drawing, from 0 to 1 */
+        float cpuShare = 0;
+        /** bytes of the LVGL heap in use */
+        std::uint32_t memoryUsed = 0;
+        /** most bytes of the LVGL heap ever in use, since the program started */
+        std::uint32_t memoryPeak = 0;
+        /** size of the LVGL heap, in bytes */
+        std::uint32_t memoryTotal = 0;
+        /** fragmentation of the LVGL heap, in percent */
+        std::uint8_t fragmentation = 0;
+        /** number of report periods that went over the budget, since start() was called */
+        std::uint32_t overBudgetCount = 0;
+};
+
+/**
+ * @brief Measures how much the brain screen costs
+ *
+ * LVGL calls a monitor callback after every refresh with the time it took and the number of pixels it redrew.
+ * DisplayMonitor installs that callback and, every report period, also reads the usage of the LVGL heap. The
+ * statistics are sent to lemlib::telemetrySink(), and every period that goes over the budget is counted, so a
+ * change to the dashboard can be checked against the budget by driving the robot and reading the report.
+ *
+ * Everything runs in the LVGL task, and getStats() can be called from any task without blocking it.
+ */
+class DisplayMonitor {
+    public:
+        /**
+         * @brief Create a new display monitor
+         *
+         * @param budget limits for the refresh time, CPU share and heap usage
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::DisplayMonitor display_monitor;
+         *
+         * void initialize() {
+         *     dashboard.start();
+         *     display_monitor.start();
+         * }
+         * @endcode
+         */
+        DisplayMonitor(DisplayBudget budget = {});
+        /**
+         * @brief Install the monitor callback and start reporting. Only one monitor can be started
+         *
+         * @return true the monitor was started
+         * @return false another monitor is already running
+         */
+        bool start();
+        /**
+         * @brief Get the statistics of the last report period
+         *
+         * @return DisplayStats
+         */
+        DisplayStats getStats() const;
+    private:
+        void onRefresh(std::uint32_t time, std::uint32_t pixels);
+        void report();
+
+        const DisplayBudget budget;
+        lv_timer_t* timer = nullptr;
+        void (*previousMonitor)(lv_disp_drv_t*, std::uint32_t, std::uint32_t) = nullptr;
+
+        // accumulated since the last report, only touched by the LVGL task
+        std::uint32_t refreshes = 0;
+        std::uint64_t totalTime = 0;
+        std::uint64_t totalPixels = 0;
+        std::uint32_t maxTime = 0;
+        std::uint32_t lastReport = 0;
+        std::uint32_t overBudgetCount = 0;
+
+        Seqlock<DisplayStats> stats;
+};
+} // namespace robot
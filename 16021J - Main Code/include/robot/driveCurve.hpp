@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include "lemlib/chassis/chassis.hpp" // driveCurve.hpp has no include guard, chassis.hpp does
+
+namespace robot {
+
+/**
+ * @brief The same curve as lemlib::ExpoDriveCurve, worked out for every input ahead of time
+ *
+ * Controller sticks only report whole numbers from -127 to 127, so all 255 outputs are calculated when the curve
+ * is created, and curve() is a table lookup instead of a call to pow(). Inputs are rounded to the nearest whole
+ * number and clamped to [-127, 127]. Outputs match lemlib::ExpoDriveCurve exactly for those inputs.
+ */
+class TableDriveCurve : public lemlib::DriveCurve {
+    public:
+        /**
+         * @brief Create a new table drive curve
+         *
+         * see https://www.desmos.com/calculator/umicbymbnl for an interactive graph
+         *
+         * @param deadband range where input is considered to be input
+         * @param minOutput the minimum output that can be returned
+         * @param curve how "curved" the graph is
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::TableDriveCurve throttle_curve(3, 10, 1.019);
+         * robot::TableDriveCurve steer_curve(3, 10, 1.019);
+         * robot::Chassis chassis(drivetrain, lateral_controller, angular_controller, sensors, &throttle_curve,
+         *                        &steer_curve);
+         * @endcode
+         */
+        TableDriveCurve(float deadband, float minOutput, float curve);
+        /**
+         * @brief curve an input
+         *
+         * @param input the input to curve, from -127 to 127
+         * @return float the curved output
+         */
+        float curve(float input) override;
+    private:
+        std::array<float, 255> table;
+};
+} // namespace robot
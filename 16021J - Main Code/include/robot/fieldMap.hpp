@@ -0,0 +1,21 @@
+#pragma once
+
+namespace robot {
+
+/** distance from the center of the field to the inside of the walls, in inches */
+constexpr float FIELD_HALF_WIDTH = 70.2;
+
+/**
+ * @brief Get the distance from a point on the field to the field wall in a given direction
+ *
+ * The distances are read from a lookup table that is generated at compile time, so this doesn't need any
+ * trigonometry and is cheap enough to call for hundreds of particles every update. The table only models the
+ * field perimeter, so a sensor pointed at the ladder, a goal or another robot will read shorter than this.
+ *
+ * @param x x position, in inches
+ * @param y y position, in inches
+ * @param theta direction, in radians. 0 is +y, clockwise is positive
+ * @return float distance to the wall, in inches
+ */
+float fieldDistance(float x, float y, float theta);
+} // namespace robot
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "liblvgl/lvgl.h"
+#include "lemlib/pose.hpp"
+#include "robot/chassis.hpp"
+
+namespace robot {
+
+/**
+ * @brief Settings for FieldView
+ */
+struct FieldViewSettings {
+        /** side length of the map, in pixels. 200 by default */
+        lv_coord_t size = 200;
+        /** width of the robot, in inches. 15 by default */
+        float robotWidth = 15;
+        /** length of the robot, in inches. 15 by default */
+        float robotLength = 15;
+        /** a point is added to the trail every time the robot moves this far, in inches. 2 by default */
+        float trailSpacing = 2;
+        /** the most points the trail keeps. Once it's full the oldest half is dropped. 500 by default */
+        size_t trailLength = 500;
+};
+
+/**
+ * @brief LVGL map of the field showing the robot, where it has been, and the path it's following
+ *
+ * The field is drawn into a canvas once. The trail and the path being tracked are drawn on top of it, and only
+ * the new part of the trail is drawn each update, so the cost of an update doesn't grow with the length of the
+ * trail and only the area around the new segment is redrawn by LVGL. The robot is a separate line object on
+ * top of the canvas, so moving it never touches the canvas. Everything is redrawn only when the path changes
+ * or the trail is cleared.
+ *
+ * The map has to be updated from the LVGL task, like from an lv_timer. Dashboard does this.
+ */
+class FieldView {
+    public:
+        /**
+         * @brief Create a new field view
+         *
+         * @param chassis the chassis, for the path it's following
+         * @param settings map size, robot size and trail settings
+         */
+        FieldView(Chassis& chassis, FieldViewSettings settings = {});
+        /**
+         * @brief Create the widgets and draw the field
+         *
+         * @param parent the object to create the map in
+         * @param x x position in the parent, in pixels
+         * @param y y position in the parent, in pixels
+         */
+        void create(lv_obj_t* parent, lv_coord_t x, lv_coord_t y);
+        /**
+         * @brief Move the robot, extend the trail, and redraw the path if it changed
+         *
+         * @param pose the pose of the robot, with theta in degrees
+         */
+        void update(lemlib::Pose pose);
+        /**
+         * @brief Erase the trail
+         */
+        void clearTrail();
+    private:
+        struct TrailPoint {
+                float x;
+                float y;
+                // whether the point is connected to the one before it, false after the pose jumps
+                bool connected;
+        };
+
+        lv_point_t toPixel(float x, float y) const;
+        void redraw();
+        void drawField();
+        void drawPath();
+        void drawTrailSegment(size_t index, bool invalidate);
+        void drawLine(lv_point_t a, lv_point_t b, lv_color_t color, bool invalidate);
+        void moveFootprint(lemlib::Pose pose);
+        void fillRect(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2, lv_color_t color);
+
+        Chassis& chassis;
+        const FieldViewSettings settings;
+        const float scale;
+
+        lv_obj_t* canvas = nullptr;
+        lv_obj_t* footprint = nullptr;
+        // the field without the trail or path, copied back into the canvas to erase them
+        std::vector<lv_color_t> field;
+        std::vector<lv_color_t> pixels;
+        lv_point_t footprintPoints[7] = {};
+
+        std::vector<TrailPoint> trail;
+        std::vector<PathPoint> path;
+        int pathVersion = -1;
+};
+} // namespace robot
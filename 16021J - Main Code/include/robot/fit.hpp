@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+
+namespace robot {
+
+/**
+ * @brief A straight line fit to some data, y = slope * x + intercept
+ */
+struct LineFit {
+        float slope = 0;
+        float intercept = 0;
+        /** how much of the variation in y is explained by the line, from 0 to 1. 1 is a perfect fit */
+        float rSquared = 0;
+};
+
+/**
+ * @brief Fit a straight line to some data with least squares
+ *
+ * @param x the x values
+ * @param y the y values
+ * @param n the number of values
+ * @return LineFit the line. Slope and intercept are 0 if there are fewer than 2 distinct x values
+ */
+LineFit fitLine(const float* x, const float* y, size_t n);
+
+/**
+ * @brief The result of calibrating one tracking wheel, see Chassis::calibrateTrackingWheels
+ */
+struct TrackingWheelFit {
+        /** whether the wheel exists and the fit succeeded */
+        bool valid = false;
+        /** the fitted offset, in inches, with the same sign convention as lemlib::TrackingWheel */
+        float offset = 0;
+        /** effective diameter divided by the diameter the wheel was constructed with. 1 if it wasn't measured */
+        float diameterScale = 1;
+        /** how well the spins fit a straight line, from 0 to 1. Below 0.999 the robot probably slid around */
+        float rSquared = 0;
+};
+
+/**
+ * @brief Find the offset and diameter of a tracking wheel from samples taken while turning in place
+ *
+ * A wheel travels -offset * angle when the robot turns in place, so the offset is the negative slope of the
+ * distances against the angles. The offset is measured with the diameter the wheel was constructed with, so it is
+ * scaled by the diameter measured by pushing the robot a known distance.
+ *
+ * @param angles the heading of each sample, in radians
+ * @param distances the distance the wheel reported at each sample, in inches
+ * @param n the number of samples
+ * @param pushDistance how far the robot was pushed along the wheel, in inches. 0 if it wasn't
+ * @param pushMeasured how far the wheel reported the push was, in inches. Pushes under an inch are ignored
+ * @return TrackingWheelFit the fit. Not valid if there are fewer than 2 samples
+ */
+TrackingWheelFit fitTrackingWheel(const float* angles, const float* distances, size_t n, float pushDistance = 0,
+                                  float pushMeasured = 0);
+} // namespace robot
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rtos.hpp"
+
+namespace robot {
+
+/**
+ * @brief Settings for FusedImu
+ */
+struct FusedImuSettings {
+        /** the robot is considered stationary while every gyro reads less than this, in degrees per second. 0.5
+         * by default */
+        float stationaryRate = 0.5;
+        /** the robot is only considered stationary while odometry reads less than this, in inches per second.
+         * 0.5 by default */
+        float stationarySpeed = 0.5;
+        /** the robot is only considered stationary while every drive motor is slower than this, in rpm. Only
+         * used after FusedImu::setMotors. 2 by default */
+        float stationaryMotorVelocity = 2;
+        /** how long the robot has to be still before it is considered stationary, in milliseconds. 250 by
+         * default */
+        int stationaryTime = 250;
+        /** how fast the bias estimate follows the drift measured while stationary, from 0 to 1. 0.02 by default */
+        float biasGain = 0.02;
+        /** IMUs whose rate differs from the others by more than this are ignored, in degrees per second. 10 by
+         * default */
+        float maxDisagreement = 10;
+        /** how many times an IMU is reset before it's given up on. 5 by default */
+        int calibrationAttempts = 5;
+};
+
+/**
+ * @brief One or more IMUs fused into a single heading
+ *
+ * FusedImu can be passed to lemlib::OdomSensors in place of a pros::Imu. Every update, 10ms unless changed with
+ * set_data_rate(), the change in rotation of each IMU is measured, corrected by that IMU's bias, and combined: the
+ * median of 3 or more IMUs, or the mean of 2 when they agree. IMUs that disagree with the others, disconnect or
+ * fail to calibrate are left out.
+ *
+ * While the robot is stationary the heading is held and the drift of each IMU is measured to update its bias,
+ * so the heading doesn't creep while waiting at the start of autonomous. A slow arc can turn slower than the
+ * stationary rate, so the robot is only stationary while the gyros, odometry and the drive motors all say so:
+ * rotation measured while the drive motors are powered or moving is never thrown away.
+ *
+ * Calibration doesn't block: reset() starts calibrating every IMU and returns, and the heading is usable as
+ * soon as any one of them is done. The IMUs must all be mounted in the same orientation.
+ */
+class FusedImu : public pros::Imu {
+    public:
+        /**
+         * @brief Create a new fused IMU
+         *
+         * @param ports the ports of the IMUs
+         * @param settings stationary detection, bias and outlier rejection settings
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::FusedImu imu({11, 12});
+         * lemlib::OdomSensors sensors(&vertical_tracking_wheel, nullptr, &horizontal_tracking_wheel, nullptr, &imu);
+         * @endcode
+         */
+        FusedImu(std::initializer_list<std::uint8_t> ports, FusedImuSettings settings = {});
+        /**
+         * @brief Only consider the robot stationary while these motors are unpowered and still
+         *
+         * @param leftMotors the left drive motors, nullptr to stop checking them
+         * @param rightMotors the right drive motors, nullptr to stop checking them
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     imu.setMotors(&left_motor_group, &right_motor_group);
+         *     chassis.calibrate();
+         * }
+         * @endcode
+         */
+        void setMotors(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors);
+        /**
+         * @brief Start calibrating every IMU
+         *
+         * @param blocking whether to wait until the heading is usable. False by default
+         * @return 1 if the calibration was started, PROS_ERR if there are no IMUs
+         */
+        std::int32_t reset(bool blocking = false) const override;
+        /**
+         * @brief Whether the heading isn't usable yet
+         *
+         * @return true no IMU has finished calibrating, and at least one is still trying
+         * @return false an IMU is calibrated, or every IMU failed to calibrate
+         */
+        bool is_calibrating() const override;
+        /**
+         * @brief Set how often every IMU reports, and how often they are fused
+         *
+         * Odometry that updates faster than the IMUs reads the same heading twice, then turns twice as far at
+         * once, so match this to the odometry period. The rate is applied again whenever an IMU finishes
+         * calibrating
+         *
+         * @param rate time between reports, in milliseconds. Multiples of 5, at least 5. 10 by default
+         * @return 1 if every IMU accepted it, PROS_ERR otherwise
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     imu.set_data_rate(5);
+         *     chassis.calibrateAsync(true, 5);
+         * }
+         * @endcode
+         */
+        std::int32_t set_data_rate(std::uint32_t rate) const override;
+        pros::ImuStatus get_status() const override;
+        /**
+         * @brief Get the fused rotation
+         *
+         * @return double rotation in degrees, clockwise is positive. PROS_ERR_F if no IMU is calibrated
+         */
+        double get_rotation() const override;
+        /**
+         * @brief Get the fused heading
+         *
+         * @return double heading in degrees, from 0 to 360. PROS_ERR_F if no IMU is calibrated
+         */
+        double get_heading() const override;
+        /**
+         * @brief Get the fused gyro rate
+         *
+         * @return pros::imu_gyro_s_t the rate of the first working IMU, with z replaced by the fused rate
+         */
+        pros::imu_gyro_s_t get_gyro_rate() const override;
+        std::int32_t set_rotation(double target) const override;
+        std::int32_t set_heading(double target) const override;
+        std::int32_t tare_rotation() const override;
+        std::int32_t tare_heading() const override;
+        std::int32_t tare() const override;
+        /**
+         * @brief Get how many IMUs are calibrated
+         *
+         * @return size_t
+         */
+        size_t getReadyCount() const;
+        /**
+         * @brief Get the estimated drift of an IMU
+         *
+         * @param index the index of the IMU, in the order of the ports passed to the constructor
+         * @return float bias in degrees per second
+         */
+        float getBias(size_t index) const;
+        /**
+         * @brief Whether the robot is currently considered stationary
+         *
+         * @return true the heading is held and the biases are being updated
+         * @return false the robot is moving
+         */
+        bool isStationary() const;
+        /**
+         * @brief Measure and fuse the IMUs. Called at the data rate by the task started by reset()
+         */
+        void update() const;
+    private:
+        struct Sensor {
+                pros::Imu imu;
+                bool ready = false;
+                int attempts = 0;
+                std::uint32_t resetTime = 0;
+                double prevRotation = 0;
+                float bias = 0;
+        };
+
+        bool motorsStill() const;
+        double fuse(double* deltas, size_t count, double dt) const;
+
+        const FusedImuSettings settings;
+        mutable std::vector<Sensor> sensors;
+        pros::MotorGroup* leftMotors = nullptr;
+        pros::MotorGroup* rightMotors = nullptr;
+        mutable pros::Mutex mutex;
+        mutable pros::Task* task = nullptr;
+        mutable double rotation = 0;
+        mutable double rate = 0;
+        mutable double prevDelta = 0;
+        mutable int stationaryFor = 0;
+        mutable std::uint32_t prevTime = 0;
+        mutable std::uint32_t period = 10;
+};
+} // namespace robot
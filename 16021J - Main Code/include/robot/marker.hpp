@@ -0,0 +1,134 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "lemlib/pose.hpp"
+
+namespace robot {
+
+/**
+ * @brief Progress of a motion, as seen by its markers
+ */
+struct MotionProgress {
+        /** distance traveled since the start of the motion, in inches */
+        float traveled;
+        /** distance left to travel, in inches */
+        float remaining;
+        /** estimated time left, in milliseconds */
+        int timeLeft;
+        /** current pose of the robot */
+        lemlib::Pose pose;
+};
+
+/**
+ * @brief An action that runs when a motion reaches a certain point
+ *
+ * Markers are checked by the motion itself, every tick of its loop, so they run at most 10ms
+ * after their trigger is reached and don't need their own task. Because of that the action has
+ * to be quick: set a piston or start a motor, never delay. Each marker runs at most once, and
+ * markers that aren't reached before the motion ends don't run at all.
+ *
+ * @b Example
+ * @code {.cpp}
+ * chassis.moveToPoint(-24, 24, 2000, {.forwards = false},
+ *                     {robot::Marker::beforeEnd(150, [] { stake_lock.set_value(1); }),
+ *                      robot::Marker::atDistance(6, [] { intake.move(127); })});
+ * @endcode
+ */
+class Marker {
+    public:
+        /**
+         * @brief Run an action once the robot has traveled a distance
+         *
+         * @param distance distance since the start of the motion, in inches. Along the path for path motions
+         * @param action the action to run
+         * @return Marker
+         */
+        static Marker atDistance(float distance, std::function<void()> action);
+        /**
+         * @brief Run an action once a fraction of the motion is done
+         *
+         * @param fraction how much of the motion has to be done, from 0 to 1
+         * @param action the action to run
+         * @return Marker
+         */
+        static Marker atFraction(float fraction, std::function<void()> action);
+        /**
+         * @brief Run an action once the robot is inside a circle on the field
+         *
+         * @param x x position of the center of the circle, in inches
+         * @param y y position of the center of the circle, in inches
+         * @param radius radius of the circle, in inches
+         * @param action the action to run
+         * @return Marker
+         */
+        static Marker inRegion(float x, float y, float radius, std::function<void()> action);
+        /**
+         * @brief Run an action a certain time before the motion is expected to end
+         *
+         * Uses the same estimate as robot::Chassis::getMotionETA()
+         *
+         * @param time time before the end of the motion, in milliseconds
+         * @param action the action to run
+         * @return Marker
+         */
+        static Marker beforeEnd(int time, std::function<void()> action);
+        /**
+         * @brief Run an action once a custom condition is true
+         *
+         * The condition is checked every tick, so it can poll sensors. Together with
+         * robot::Chassis::cancelMotion() this can be used as an extra exit condition for a motion
+         *
+         * @param condition returns true once the action should run
+         * @param action the action to run
+         * @return Marker
+         *
+         * @b Example
+         * @code {.cpp}
+         * // stop backing up as soon as the robot hits the stake, and clamp it
+         * robot::ContactDetector contact(&left_motor_group, &right_motor_group);
+         * chassis.moveToPoint(-24, 24, 2000, {.forwards = false},
+         *                     {robot::Marker::when([&](const robot::MotionProgress&) { return contact.update(); },
+         *                                          [&] {
+         *                                              stake_lock.set_value(1);
+         *                                              chassis.cancelMotion();
+         *                                          })});
+         * @endcode
+         */
+        static Marker when(std::function<bool(const MotionProgress&)> condition, std::function<void()> action);
+        /**
+         * @brief Check the marker, and run its action if it has been reached
+         *
+         * @param progress progress of the motion
+         * @return true the action ran during this call
+         * @return false the action didn't run
+         */
+        bool update(const MotionProgress& progress);
+    private:
+        enum class Trigger { DISTANCE, FRACTION, REGION, TIME_LEFT, CONDITION };
+
+        Marker(Trigger trigger, float value, float x, float y, std::function<void()> action,
+               std::function<bool(const MotionProgress&)> condition = nullptr);
+
+        Trigger trigger;
+        float value;
+        float x;
+        float y;
+        std::function<void()> action;
+        std::function<bool(const MotionProgress&)> condition;
+        bool done = false;
+};
+
+/**
+ * @brief The markers of a motion
+ */
+using Markers = std::vector<Marker>;
+
+/**
+ * @brief Check every marker of a motion
+ *
+ * @param markers the markers to check
+ * @param progress progress of the motion
+ */
+void updateMarkers(Markers& markers, const MotionProgress& progress);
+} // namespace robot
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace robot {
+
+/**
+ * @brief A small, fixed size matrix of floats
+ *
+ * The size is part of the type and the elements are stored inline, so matrices never
+ * allocate and can be used freely in control loops
+ *
+ * @tparam R number of rows
+ * @tparam C number of columns
+ */
+template <size_t R, size_t C> class Matrix {
+    public:
+        std::array<float, R * C> data {};
+
+        /**
+         * @brief Create an identity matrix
+         *
+         * @return Matrix
+         */
+        static Matrix identity() {
+            static_assert(R == C, "only square matrices have an identity");
+            Matrix m;
+            for (size_t i = 0; i < R; i++) m(i, i) = 1;
+            return m;
+        }
+
+        float& operator()(size_t row, size_t col) { return data[row * C + col]; }
+
+        float operator()(size_t row, size_t col) const { return data[row * C + col]; }
+
+        Matrix operator+(const Matrix& other) const {
+            Matrix m;
+            for (size_t i = 0; i < R * C; i++) m.data[i] = data[i] + other.data[i];
+            return m;
+        }
+
+        Matrix operator-(const Matrix& other) const {
+            Matrix m;
+            for (size_t i = 0; i < R * C; i++) m.data[i] = data[i] - other.data[i];
+            return m;
+        }
+
+        Matrix operator*(float scalar) const {
+            Matrix m;
+            for (size_t i = 0; i < R * C; i++) m.data[i] = data[i] * scalar;
+            return m;
+        }
+
+        template <size_t K> Matrix<R, K> operator*(const Matrix<C, K>& other) const {
+            Matrix<R, K> m;
+            for (size_t i = 0; i < R; i++)
+                for (size_t k = 0; k < C; k++)
+                    for (size_t j = 0; j < K; j++) m(i, j) += (*this)(i, k) * other(k, j);
+            return m;
+        }
+
+        Matrix<C, R> transpose() const {
+            Matrix<C, R> m;
+            for (size_t i = 0; i < R; i++)
+                for (size_t j = 0; j < C; j++) m(j, i) = (*this)(i, j);
+            return m;
+        }
+};
+
+/**
+ * @brief Invert a square matrix with Gauss-Jordan elimination
+ *
+ * @param m the matrix to invert
+ * @param out where the inverse is written
+ * @return true the matrix was inverted
+ * @return false the matrix is singular, out is left unchanged
+ */
+template <size_t N> bool invert(const Matrix<N, N>& m, Matrix<N, N>& out) {
+    Matrix<N, N> a = m;
+    Matrix<N, N> inv = Matrix<N, N>::identity();
+    for (size_t col = 0; col < N; col++) {
+        // partial pivoting
+        size_t pivot = col;
+        for (size_t row = col + 1; row < N; row++)
+            if (std::fabs(a(row, col)) > std::fabs(a(pivot, col))) pivot = row;
+        if (std::fabs(a(pivot, col)) < 1e-9f) return false;
+        for (size_t j = 0; j < N; j++) {
+            std::swap(a(col, j), a(pivot, j));
+            std::swap(inv(col, j), inv(pivot, j));
+        }
+        const float scale = 1 / a(col, col);
+        for (size_t j = 0; j < N; j++) {
+            a(col, j) *= scale;
+            inv(col, j) *= scale;
+        }
+        for (size_t row = 0; row < N; row++) {
+            if (row == col) continue;
+            const float factor = a(row, col);
+            for (size_t j = 0; j < N; j++) {
+                a(row, j) -= factor * a(col, j);
+                inv(row, j) -= factor * inv(col, j);
+            }
+        }
+    }
+    out = inv;
+    return true;
+}
+} // namespace robot
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "lemlib/pose.hpp"
+#include "robot/poseHistory.hpp"
+
+namespace robot {
+
+/**
+ * @brief Start the odometry task, updating the LemLib pose at a custom rate
+ *
+ * lemlib::init() always updates odometry every 10ms. Rotation sensors can report every 5ms once
+ * pros::Rotation::set_data_rate(5) is called, and updating odometry as often means less of the robot's
+ * motion is integrated as a single straight step, which reduces the error on fast turns and arcs.
+ * Every update is also recorded in the pose history, see getPoseHistory(). Sensors must be passed to LemLib with
+ * lemlib::setSensors first. Does nothing if odometry is already running
+ *
+ * @param period time between updates, in milliseconds. 10 by default
+ *
+ * @b Example
+ * @code {.cpp}
+ * vertical_rotation.set_data_rate(5);
+ * horizontal_rotation.set_data_rate(5);
+ * lemlib::setSensors(sensors, drivetrain);
+ * robot::startOdom(5);
+ * @endcode
+ */
+void startOdom(int period = 10);
+/**
+ * @brief Get the period of the odometry task
+ *
+ * @return int time between updates, in milliseconds
+ */
+int getOdomPeriod();
+/**
+ * @brief Get the pose of the robot without locking
+ *
+ * The odometry task publishes a snapshot of the pose after every update, and this reads it with a Seqlock, so
+ * any number of tasks can read the pose without ever making odometry wait, and x, y and theta always come from
+ * the same update. If this preempted a write, it sleeps until the write is done. Set the pose with setPose or
+ * correctPose so the snapshot stays up to date
+ *
+ * @param radians true for theta in radians, false for degrees. False by default
+ * @param standardPos true for theta in standard form (0 is +x, counterclockwise is positive), false for
+ * LemLib's form (0 is +y, clockwise is positive). False by default
+ * @return lemlib::Pose
+ */
+lemlib::Pose getPose(bool radians = false, bool standardPos = false);
+/**
+ * @brief Set the pose of the robot, and publish it to getPose
+ *
+ * @param pose the new pose, with theta in LemLib's form
+ * @param radians true if theta is in radians, false for degrees. False by default
+ */
+void setPose(lemlib::Pose pose, bool radians = false);
+/**
+ * @brief Add a correction to the pose of the robot, like one from a pose estimator
+ *
+ * Unlike reading the pose and setting it, no odometry update can happen in between and get lost
+ *
+ * @param correction the change in x, y and theta, with theta in radians
+ */
+void correctPose(lemlib::Pose correction);
+/**
+ * @brief Get the history of poses recorded by the odometry task started with startOdom
+ *
+ * @return const PoseHistory&
+ */
+const PoseHistory& getPoseHistory();
+/**
+ * @brief Get the speed of the robot, corrected for the odometry period
+ *
+ * lemlib::getSpeed assumes odometry updates every 10ms. Use this instead when odometry was started with
+ * startOdom at a different rate
+ *
+ * @param radians true for theta in radians, false for degrees. False by default
+ * @return lemlib::Pose speed in inches per second, and degrees or radians per second
+ */
+lemlib::Pose getSpeed(bool radians = false);
+} // namespace robot
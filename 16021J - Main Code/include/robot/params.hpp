@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "pros/rtos.hpp"
+
+namespace robot {
+
+/**
+ * @brief The type of a parameter, as stored on the SD card
+ */
+enum class ParamType : std::uint8_t { INT = 0, FLOAT = 1 };
+
+/**
+ * @brief A registry of parameters that can be changed while the program runs, and saved to the SD card
+ *
+ * Parameters are declared as globals with their compiled default, like `robot::Param<int> speed {params,
+ * "speed", 127};`. load() replaces the defaults with the values saved on the SD card, if there are any, and
+ * save() saves the current values. Values can be listed and changed over serial with handle(), see Tuner.
+ *
+ * The file format is a 12 byte header (magic, schema version, parameter count, generation), then 9 bytes per
+ * parameter (hash of the name, type, value) and a CRC32 of all of it. Parameters are matched by name and type,
+ * so adding or removing a parameter keeps the saved values of the others. Files with a different schema version
+ * are ignored, so bump it when the meaning or units of a parameter change.
+ *
+ * Saving never overwrites the only good copy: there are two files, and save() writes the older one with a
+ * higher generation. load() uses the newest file with a valid checksum, so losing power during a save just
+ * loads the previous save.
+ */
+class ParamStore {
+    public:
+        /**
+         * @brief Create a new parameter store
+         *
+         * @param schemaVersion version of the meaning of the parameters. Files saved with another version are
+         * ignored
+         * @param path path of the files, without the extension. "/usd/params" by default, which saves to
+         * /usd/params.0 and /usd/params.1
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::ParamStore params(1);
+         * robot::Param<int> intake_velocity {params, "intake.velocity", 127};
+         *
+         * void initialize() {
+         *     params.load();
+         * }
+         *
+         * void opcontrol() {
+         *     intake.move(intake_velocity); // a plain load, no locks
+         * }
+         * @endcode
+         */
+        ParamStore(std::uint16_t schemaVersion, const char* path = "/usd/params");
+        /**
+         * @brief Load the newest valid save from the SD card
+         *
+         * @return true the values were loaded
+         * @return false there's no SD card or no valid save, so the parameters keep their defaults
+         */
+        bool load();
+        /**
+         * @brief Save the current values to the SD card
+         *
+         * @return true the values were saved
+         * @return false there's no SD card, or writing failed
+         */
+        bool save();
+        /**
+         * @brief Set every parameter back to its default. Doesn't save
+         */
+        void reset();
+        /**
+         * @brief Set a parameter from text
+         *
+         * @param name the name of the parameter
+         * @param value the new value
+         * @return true the parameter was set
+         * @return false there's no parameter with that name, or the value couldn't be parsed
+         */
+        bool set(const char* name, const char* value);
+        /**
+         * @brief Run a serial command
+         *
+         * `param list` prints every parameter as `param <name> <value>`, `param set <name> <value>` changes one,
+         * `param save` saves them, `param reset` sets them back to their defaults
+         *
+         * @param command the command, without the newline
+         * @return true the command was a param command
+         * @return false the command wasn't a param command
+         */
+        bool handle(const char* command);
+        /** the maximum number of parameters */
+        static constexpr size_t MAX_PARAMS = 64;
+    private:
+        template <typename T> friend class Param;
+
+        struct Entry {
+                const char* name;
+                std::uint32_t hash;
+                ParamType type;
+                std::atomic<std::uint32_t>* bits;
+                std::uint32_t defaultBits;
+                void (*onChange)();
+        };
+
+        void add(Entry entry);
+        void print(const Entry& entry) const;
+        bool read(int slot, std::uint32_t& fileGeneration, bool apply);
+
+        const std::uint16_t schemaVersion;
+        const char* const path;
+        std::array<Entry, MAX_PARAMS> entries {};
+        size_t count = 0;
+        std::uint32_t generation = 0;
+        int newestSlot = -1;
+        // only held while loading and saving, never while a parameter is read
+        pros::Mutex mutex;
+};
+
+/**
+ * @brief A parameter registered in a ParamStore
+ *
+ * Reading it is a single relaxed atomic load, which is a plain load on the V5, so it's fine to read in control
+ * loops.
+ *
+ * @tparam T int, float or bool
+ */
+template <typename T> class Param {
+        static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, bool>,
+                      "parameters have to be int, float or bool");
+    public:
+        /**
+         * @brief Create a parameter and register it
+         *
+         * @param store the store to register it in
+         * @param name the name of the parameter, used to match it with the saved value. Has to stay alive
+         * @param defaultValue the value used when nothing is saved
+         * @param onChange called after the value is changed by the store, like to apply new gains. nullptr by
+         * default
+         */
+        Param(ParamStore& store, const char* name, T defaultValue, void (*onChange)() = nullptr)
+            : bits(toBits(defaultValue)) {
+            store.add({name, 0, std::is_same_v<T, float> ? ParamType::FLOAT : ParamType::INT, &bits,
+                       toBits(defaultValue), onChange});
+        }
+
+        /**
+         * @brief Get the value
+         *
+         * @return T
+         */
+        T get() const { return fromBits(bits.load(std::memory_order_relaxed)); }
+
+        operator T() const { return get(); }
+    private:
+        static std::uint32_t toBits(T value) {
+            if constexpr (std::is_same_v<T, float>) {
+                std::uint32_t result;
+                std::memcpy(&result, &value, sizeof(result));
+                return result;
+            } else {
+                return static_cast<std::uint32_t>(static_cast<std::int32_t>(value));
+            }
+        }
+
+        static T fromBits(std::uint32_t value) {
+            if constexpr (std::is_same_v<T, float>) {
+                float result;
+                std::memcpy(&result, &value, sizeof(result));
+                return result;
+            } else {
+                return static_cast<T>(static_cast<std::int32_t>(value));
+            }
+        }
+
+        std::atomic<std::uint32_t> bits;
+};
+} // namespace robot
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/pose.hpp"
+#include "robot/poseEstimator.hpp"
+#include "robot/slipDetector.hpp"
+
+namespace robot {
+
+/**
+ * @brief Settings for ParticleFilter
+ */
+struct ParticleFilterSettings {
+        /** number of particles. The time an update takes grows with the number of particles times the number
+         * of wall sensors, use ParticleFilter::getParticlesPerSecond to fit it in the CPU budget. 300 by default */
+        size_t particles = 300;
+        /** time between updates, in milliseconds. 50 by default */
+        int period = 50;
+        /** standard deviation of the position error added by odometry, in inches per inch traveled. 0.05 by
+         * default */
+        float odomDrift = 0.05;
+        /** standard deviation of the heading error added by odometry, in radians per radian turned. 0.02 by
+         * default */
+        float headingDrift = 0.02;
+        /** standard deviation of a distance sensor reading, as a fraction of the reading. 0.05 by default */
+        float distanceStdDev = 0.05;
+        /** distance sensor readings with a lower confidence are ignored, from 0 to 63. 40 by default */
+        int distanceMinConfidence = 40;
+        /** corrections smaller than this aren't written back to odometry, in inches. 0.5 by default */
+        float publishThreshold = 0.5;
+};
+
+/**
+ * @brief Monte Carlo localization with distance sensors against the field walls
+ *
+ * Each particle is a guess of the pose of the robot. Every update the particles are moved by the change in the
+ * LemLib odometry pose plus some noise, weighted by how well the distance sensor readings match the distances
+ * they would read from that pose, and resampled. Unlike PoseEstimator, the particles can represent more than
+ * one guess at a time, so the filter recovers from large errors like a collision at the start of a skills run.
+ *
+ * Expected distances come from the lookup table in fieldMap.hpp, and the particles are stored as separate
+ * arrays of x, y, theta and weight so the per particle loops are simple and vectorizable. The arrays are
+ * allocated once in the constructor.
+ */
+class ParticleFilter {
+    public:
+        /**
+         * @brief Create a new particle filter
+         *
+         * @param settings number of particles and noise settings
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Distance left_distance(13);
+         * pros::Distance back_distance(14);
+         * robot::ParticleFilter localizer;
+         *
+         * void initialize() {
+         *     chassis.calibrate(); // waits until robot::Chassis odometry is running
+         *     localizer.addWallSensor({&left_distance, -6, 0, -90}); // faces left, 6 inches left of center
+         *     localizer.addWallSensor({&back_distance, 0, -7, 180}); // faces back, 7 inches behind center
+         *     localizer.start();
+         * }
+         * @endcode
+         */
+        ParticleFilter(ParticleFilterSettings settings = {});
+        /**
+         * @brief Add a distance sensor that measures the distance to the field walls
+         *
+         * @param sensor the sensor and where it is mounted
+         * @return true the sensor was added
+         * @return false there are already MAX_WALL_SENSORS sensors
+         */
+        bool addWallSensor(WallSensor sensor);
+        /**
+         * @brief Trust odometry less while a slip detector reports slip or a collision
+         *
+         * @param detector the slip detector, nullptr to stop using it
+         */
+        void setSlipDetector(const SlipDetector* detector);
+        /**
+         * @brief Start updating the filter in a low priority task
+         */
+        void start();
+        /**
+         * @brief Run one step of the filter. Called by the task started with start()
+         */
+        void update();
+        /**
+         * @brief Spread the particles around the current odometry pose
+         *
+         * @param positionStdDev standard deviation of the position, in inches
+         * @param headingStdDev standard deviation of the heading, in degrees
+         */
+        void reset(float positionStdDev = 2, float headingStdDev = 3);
+        /**
+         * @brief Get the estimated pose, the weighted mean of the particles
+         *
+         * @param radians true for theta in radians, false for degrees. False by default
+         * @return lemlib::Pose
+         */
+        lemlib::Pose getPose(bool radians = false) const;
+        /**
+         * @brief Get how many particles the filter processed per second during the last update
+         *
+         * Useful to pick a particle count that fits in the CPU budget
+         *
+         * @return float particles per second
+         */
+        float getParticlesPerSecond() const;
+        /** the maximum number of wall sensors */
+        static constexpr size_t MAX_WALL_SENSORS = PoseEstimator::MAX_WALL_SENSORS;
+    private:
+        void predict(const lemlib::Pose& odom);
+        bool weigh();
+        void estimate();
+        void resample();
+        void publish();
+        float uniform();
+        float gaussian();
+
+        const ParticleFilterSettings settings;
+        std::array<WallSensor, MAX_WALL_SENSORS> walls {};
+        size_t wallCount = 0;
+        const SlipDetector* slipDetector = nullptr;
+
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<float> thetas;
+        std::vector<float> weights;
+        // scratch space for resampling
+        std::vector<float> nextXs;
+        std::vector<float> nextYs;
+        std::vector<float> nextThetas;
+
+        lemlib::Pose pose = {0, 0, 0};
+        lemlib::Pose prevOdom = {0, 0, 0};
+        std::uint32_t seed = 0x9e3779b9;
+        float particlesPerSecond = 0;
+        pros::Task* task = nullptr;
+};
+} // namespace robot
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "lemlib/asset.hpp"
+#include "lemlib/pose.hpp"
+
+namespace robot {
+
+/**
+ * @brief A single point of a parsed path
+ */
+struct PathPoint {
+        /** x position, in inches */
+        float x;
+        /** y position, in inches */
+        float y;
+        /** target speed at this point, 0-127 */
+        float speed;
+        /** distance along the path from the first point, in inches */
+        float distance;
+        /** signed curvature of the path at this point, in 1/inches. Positive is counter-clockwise */
+        float curvature;
+        /** time to drive from the first point to this one, in seconds times the top speed of the drivetrain in
+         * inches per second. Divide by the top speed to get seconds */
+        float time = 0;
+};
+
+/**
+ * @brief A path generated by path.jerryio, parsed once and annotated for path tracking
+ *
+ * LemLib parses the path asset at the start of every follow() call and only stores the
+ * position and speed of each point. This class parses the asset once and also stores the
+ * distance along the path and the curvature of every point, so that path trackers can do
+ * arc-length based queries (lookahead, waitUntil, remaining distance) in bounded time.
+ */
+class Path {
+    public:
+        /**
+         * @brief Parse a path asset
+         *
+         * @param path the path asset, in the LemLib v0.5 format exported by path.jerryio
+         *
+         * @b Example
+         * @code {.cpp}
+         * ASSET(path_txt);
+         * robot::Path path(path_txt);
+         * printf("path is %f inches long\n", path.length());
+         * @endcode
+         */
+        Path(const asset& path);
+        /**
+         * @brief Create a path from a list of points
+         *
+         * @param points the points of the path. The distance, curvature and time fields are recalculated
+         */
+        Path(std::vector<PathPoint> points);
+        /**
+         * @brief Get the number of points in the path
+         *
+         * @return size_t
+         */
+        size_t size() const;
+        /**
+         * @brief Get a point of the path
+         *
+         * @param index index of the point
+         * @return const PathPoint&
+         */
+        const PathPoint& operator[](size_t index) const;
+        /**
+         * @brief Get the length of the drivable part of the path
+         *
+         * path.jerryio pads the end of a path with points that have a speed of 0. The robot stops at
+         * the first of those, so that is where the path ends as far as tracking is concerned
+         *
+         * @return float length in inches
+         */
+        float length() const;
+        /**
+         * @brief Find the point closest to a pose
+         *
+         * Only points in [start, start + window) are searched, so the cost is bounded and the
+         * tracker can't jump to a later part of the path where it crosses itself
+         *
+         * @param pose the pose to search from
+         * @param start index of the first point to check
+         * @param window maximum number of points to check
+         * @return size_t index of the closest point
+         */
+        size_t closestIndex(lemlib::Pose pose, size_t start, size_t window) const;
+        /**
+         * @brief Find the index of the last point at or before a distance along the path
+         *
+         * @param distance distance along the path, in inches
+         * @param hint index to start searching from. The search only moves forward from here
+         * @return size_t
+         */
+        size_t indexAt(float distance, size_t hint = 0) const;
+        /**
+         * @brief Get the position on the path at a distance along the path
+         *
+         * @param distance distance along the path, in inches. Clamped to the path
+         * @param hint index to start searching from
+         * @return lemlib::Pose position, theta is the interpolated speed
+         */
+        lemlib::Pose sample(float distance, size_t hint = 0) const;
+        /**
+         * @brief Get the largest curvature magnitude between two distances along the path
+         *
+         * @param from start distance, in inches
+         * @param to end distance, in inches
+         * @param hint index to start searching from
+         * @return float curvature in 1/inches
+         */
+        float maxCurvature(float from, float to, size_t hint = 0) const;
+        /**
+         * @brief Estimate how long it takes to drive the path
+         *
+         * The speed of each point is treated as a fraction of the top speed of the drivetrain,
+         * so a speed of 127 is maxVelocity. The time to each point is calculated when the path is
+         * created, so this is a lookup that path trackers can call every tick
+         *
+         * @param maxVelocity speed of the robot at a speed of 127, in inches per second
+         * @param from distance along the path to start from, in inches. 0 by default
+         * @param hint index to start searching from
+         * @return float time in seconds
+         */
+        float duration(float maxVelocity, float from = 0, size_t hint = 0) const;
+    private:
+        void annotate();
+        float timeAt(float distance, size_t hint) const;
+
+        std::vector<PathPoint> points;
+        float endDistance = 0;
+        float endTime = 0;
+};
+} // namespace robot
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "robot/seqlock.hpp"
+
+namespace robot {
+
+/**
+ * @brief Gains of a PID controller
+ */
+struct PIDGains {
+        /** proportional gain */
+        float kP;
+        /** integral gain */
+        float kI;
+        /** derivative gain */
+        float kD;
+        /** the integral is only accumulated while the error is smaller than this. 0 to always accumulate */
+        float windupRange;
+};
+
+/**
+ * @brief PID controller with gains that can be changed while it runs
+ *
+ * Works like lemlib::PID, but the gains are stored in a Seqlock instead of const members. Every update reads
+ * all of the gains at once, so a tick never mixes old and new gains, and changing them never blocks or
+ * allocates. Only one task may change the gains at a time.
+ */
+class PID {
+    public:
+        /**
+         * @brief Create a new PID controller
+         *
+         * @param kP proportional gain
+         * @param kI integral gain
+         * @param kD derivative gain
+         * @param windupRange the integral is only accumulated while the error is smaller than this. 0 by default
+         * @param signFlipReset whether the integral is reset when the error changes sign. False by default
+         */
+        PID(float kP, float kI, float kD, float windupRange = 0, bool signFlipReset = false);
+        /**
+         * @brief Update the controller
+         *
+         * @param error the error
+         * @return float the output
+         */
+        float update(float error);
+        /**
+         * @brief Reset the integral and derivative
+         */
+        void reset();
+        /**
+         * @brief Change the gains. Takes effect on the next update
+         *
+         * @param gains the new gains
+         */
+        void setGains(PIDGains gains);
+        /**
+         * @brief Get the gains
+         *
+         * @return PIDGains
+         */
+        PIDGains getGains() const;
+    private:
+        Seqlock<PIDGains> gains;
+        const bool signFlipReset;
+
+        float integral = 0;
+        float prevError = 0;
+};
+} // namespace robot
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "pros/distance.hpp"
+#include "pros/gps.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/pose.hpp"
+#include "robot/matrix.hpp"
+#include "robot/slipDetector.hpp"
+
+namespace robot {
+
+/**
+ * @brief A distance sensor pointed at the field walls, and where it is mounted on the robot
+ */
+struct WallSensor {
+        /** the sensor */
+        pros::Distance* sensor = nullptr;
+        /** offset of the sensor to the right of the tracking center, in inches */
+        float x = 0;
+        /** offset of the sensor in front of the tracking center, in inches */
+        float y = 0;
+        /** direction the sensor faces relative to the front of the robot, in degrees. 90 is right */
+        float angle = 0;
+};
+
+/**
+ * @brief Noise and gating settings for PoseEstimator
+ */
+struct EstimatorSettings {
+        /** standard deviation of the position error added by odometry, in inches per inch traveled. 0.03 by
+         * default */
+        float odomDrift = 0.03;
+        /** standard deviation of the heading error added by odometry, in radians per radian turned. 0.01 by
+         * default */
+        float headingDrift = 0.01;
+        /** GPS readings with an error larger than this are ignored, in meters. 0.05 by default */
+        float gpsMaxError = 0.05;
+        /** standard deviation of the GPS heading, in degrees. 2 by default */
+        float gpsHeadingStdDev = 2;
+        /** standard deviation of a distance sensor reading, as a fraction of the reading. 0.05 by default */
+        float distanceStdDev = 0.05;
+        /** distance sensor readings with a lower confidence are ignored, from 0 to 63. 40 by default */
+        int distanceMinConfidence = 40;
+        /** readings whose squared mahalanobis distance is larger than this are rejected as outliers, like a
+         * distance sensor seeing a robot instead of the wall. 9 by default */
+        float gate = 9;
+        /** distance from the center of the field to the inside of the walls, in inches. 70.2 by default */
+        float fieldHalfWidth = 70.2;
+        /** corrections smaller than this aren't written back to odometry, in inches. 0.25 by default */
+        float publishThreshold = 0.25;
+};
+
+/**
+ * @brief Extended Kalman filter that corrects LemLib odometry with a GPS sensor and distance sensors
+ *
+ * Tracking wheels and the IMU are very accurate over short distances, but their error grows without bound over
+ * a skills run. This filter uses the change in the LemLib odometry pose every tick as its motion model, then
+ * corrects the pose with absolute measurements:
+ * - the position and heading of a pros::Gps, weighted by the error it reports
+ * - distance sensor readings to the field walls
+ *
+ * Whenever the filtered pose drifts from the odometry pose by more than the publish threshold, the difference
+ * is written back with robot::correctPose, so every motion uses the corrected pose. The state is the pose in
+ * LemLib's convention (heading in radians, 0 is +y, clockwise is positive), and all of the math is done with
+ * fixed size matrices, so an update never allocates.
+ */
+class PoseEstimator {
+    public:
+        /** the maximum number of wall sensors */
+        static constexpr size_t MAX_WALL_SENSORS = 4;
+
+        /**
+         * @brief Create a new pose estimator
+         *
+         * @param gps the GPS sensor, nullptr if there is none. Set its offset from the tracking center with
+         * pros::Gps::set_offset so it reports the position of the tracking center
+         * @param settings noise and gating settings
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Gps gps(12, 0, -0.1); // GPS on port 12, 0.1m behind the tracking center
+         * pros::Distance left_distance(13);
+         * robot::PoseEstimator estimator(&gps);
+         *
+         * void initialize() {
+         *     chassis.calibrate(); // waits until robot::Chassis odometry is running
+         *     estimator.addWallSensor({&left_distance, -6, 0, -90}); // faces left, 6 inches left of center
+         *     estimator.start();
+         * }
+         * @endcode
+         */
+        PoseEstimator(pros::Gps* gps, EstimatorSettings settings = {});
+        /**
+         * @brief Add a distance sensor that measures the distance to the field walls
+         *
+         * @param sensor the sensor and where it is mounted
+         * @return true the sensor was added
+         * @return false there are already MAX_WALL_SENSORS sensors
+         */
+        bool addWallSensor(WallSensor sensor);
+        /**
+         * @brief Trust odometry less while a slip detector reports slip or a collision
+         *
+         * @param detector the slip detector, nullptr to stop using it
+         */
+        void setSlipDetector(const SlipDetector* detector);
+        /**
+         * @brief Start updating the estimator every 10ms in its own task
+         */
+        void start();
+        /**
+         * @brief Run one step of the filter. Called by the task started with start()
+         */
+        void update();
+        /**
+         * @brief Reset the filter to the current odometry pose, with the given uncertainty
+         *
+         * @param positionStdDev standard deviation of the position, in inches
+         * @param headingStdDev standard deviation of the heading, in degrees
+         */
+        void reset(float positionStdDev = 1, float headingStdDev = 1);
+        /**
+         * @brief Get the filtered pose
+         *
+         * @param radians true for theta in radians, false for degrees. False by default
+         * @return lemlib::Pose
+         */
+        lemlib::Pose getPose(bool radians = false) const;
+        /**
+         * @brief Get the covariance of the filtered pose
+         *
+         * @return Matrix<3, 3> covariance of x, y (inches) and theta (radians)
+         */
+        Matrix<3, 3> getCovariance() const;
+    private:
+        void predict(const lemlib::Pose& odom);
+        void updateGps();
+        void updateWall(const WallSensor& wall);
+        float expectedWallDistance(const Matrix<3, 1>& pose, const WallSensor& wall) const;
+        void publish();
+
+        pros::Gps* gps;
+        const EstimatorSettings settings;
+        std::array<WallSensor, MAX_WALL_SENSORS> walls {};
+        size_t wallCount = 0;
+        const SlipDetector* slipDetector = nullptr;
+
+        Matrix<3, 1> state;
+        Matrix<3, 3> covariance;
+        lemlib::Pose prevOdom = {0, 0, 0};
+        pros::Task* task = nullptr;
+};
+} // namespace robot
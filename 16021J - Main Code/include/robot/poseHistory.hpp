@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "lemlib/pose.hpp"
+#include "robot/seqlock.hpp"
+
+namespace robot {
+
+/**
+ * @brief The poses of the robot over the last few seconds, recorded every odometry update
+ *
+ * Odometry pushes its pose every update, and any task can look up where the robot was at a time in the past,
+ * interpolated between updates. This is useful to apply a measurement that arrives late, like a GPS reading,
+ * to the pose at the time it was taken, and to get the speed of the robot without reading any sensors.
+ *
+ * The history is a fixed size ring buffer, so it never allocates. Reading it never blocks odometry: every
+ * entry is a Seqlock, and an entry overwritten while it was being read is detected and skipped.
+ */
+class PoseHistory {
+    public:
+        /** the number of poses kept. 2.56 seconds at 10ms per update, 1.28 seconds at 5ms */
+        static constexpr size_t CAPACITY = 256;
+
+        /**
+         * @brief Record a pose. Only one task may record poses, which is the odometry task
+         *
+         * @param time time of the pose, in milliseconds since the program started
+         * @param pose the pose, with theta in radians
+         */
+        void push(std::uint32_t time, const lemlib::Pose& pose);
+        /**
+         * @brief Get the pose of the robot at a time in the past
+         *
+         * @param time the time, in milliseconds since the program started
+         * @param pose where the pose is written
+         * @param radians true for theta in radians, false for degrees. False by default
+         * @return true the pose was found
+         * @return false the time is newer than the latest pose or older than the history goes back
+         *
+         * @b Example
+         * @code {.cpp}
+         * // where was the robot 40ms ago?
+         * lemlib::Pose pose(0, 0, 0);
+         * if (robot::getPoseHistory().poseAt(pros::millis() - 40, pose)) printf("x: %f\n", pose.x);
+         * @endcode
+         */
+        bool poseAt(std::uint32_t time, lemlib::Pose& pose, bool radians = false) const;
+        /**
+         * @brief Get the average velocity of the robot over a window ending at a time in the past
+         *
+         * @param time the end of the window, in milliseconds since the program started
+         * @param velocity where the velocity is written, in inches per second and degrees or radians per second
+         * @param window length of the window, in milliseconds. Longer windows are smoother. 50 by default
+         * @param radians true for theta in radians, false for degrees. False by default
+         * @return true the velocity was found
+         * @return false the window isn't covered by the history
+         */
+        bool velocityAt(std::uint32_t time, lemlib::Pose& velocity, int window = 50, bool radians = false) const;
+        /**
+         * @brief Get the time of the latest pose
+         *
+         * @return std::uint32_t time in milliseconds since the program started. 0 if there are no poses yet
+         */
+        std::uint32_t latestTime() const;
+    private:
+        struct Entry {
+                /** how many poses were pushed before this one, to detect entries that have been overwritten */
+                std::uint32_t index;
+                std::uint32_t time;
+                float x;
+                float y;
+                float theta;
+        };
+
+        bool get(std::uint32_t index, Entry& entry) const;
+
+        std::array<Seqlock<Entry>, CAPACITY> entries;
+        std::atomic<std::uint32_t> count {0};
+};
+} // namespace robot
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace robot {
+
+/**
+ * @brief A fixed size queue between one producer task and one consumer task, without locks
+ *
+ * Neither side ever waits: push() drops the value if the queue is full, and pop() returns false if it's
+ * empty. Each side only writes its own index, so a push is a copy and two atomic stores.
+ *
+ * @tparam T the type of the values
+ * @tparam N the capacity. Must be a power of 2
+ */
+template <typename T, size_t N> class RingBuffer {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity has to be a power of 2");
+    public:
+        /**
+         * @brief Add a value to the queue. Only one task may push values
+         *
+         * @param value the value
+         * @return true the value was added
+         * @return false the queue is full, so the value was dropped
+         */
+        bool push(const T& value) {
+            const std::uint32_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) >= N) {
+                dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+            buffer[h % N] = value;
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Take the oldest value out of the queue. Only one task may pop values
+         *
+         * @param value set to the oldest value, if there is one
+         * @return true a value was taken
+         * @return false the queue is empty
+         */
+        bool pop(T& value) {
+            const std::uint32_t t = tail.load(std::memory_order_relaxed);
+            if (t == head.load(std::memory_order_acquire)) return false;
+            value = buffer[t % N];
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Get the number of values in the queue
+         *
+         * @return size_t
+         */
+        size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Get how many values were dropped because the queue was full
+         *
+         * @return std::uint32_t
+         */
+        std::uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    private:
+        std::array<T, N> buffer {};
+        std::atomic<std::uint32_t> head {0};
+        std::atomic<std::uint32_t> tail {0};
+        std::atomic<std::uint32_t> dropped {0};
+};
+} // namespace robot
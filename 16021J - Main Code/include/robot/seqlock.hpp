@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "pros/rtos.h"
+
+namespace robot {
+
+/**
+ * @brief A value shared between one writer and any number of readers, without locks
+ *
+ * The writer never waits. A reader copies the value, then checks that the writer didn't change it in the
+ * meantime, and tries again if it did. Since writes take a few nanoseconds this almost never happens, and a
+ * reader always gets a consistent copy, never half of an old value and half of a new one.
+ *
+ * The brain has a single core, so a reader that preempted the writer halfway through a write would spin forever
+ * if it only retried: the writer can't finish while a higher priority task is running. After a few retries the
+ * reader sleeps for a millisecond, which lets the writer finish.
+ *
+ * The value is stored as 32 bit atomic words, so this is well defined for any trivially copyable type.
+ *
+ * @tparam T the type of the value. Must be trivially copyable, with a size that is a multiple of 4 bytes
+ */
+template <typename T> class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "Seqlock values have to be trivially copyable");
+        static_assert(sizeof(T) % sizeof(std::uint32_t) == 0, "Seqlock values have to be a multiple of 4 bytes");
+        static constexpr size_t WORDS = sizeof(T) / sizeof(std::uint32_t);
+        // retries before a reader assumes the writer was preempted and sleeps to let it finish
+        static constexpr int MAX_SPINS = 8;
+    public:
+        /**
+         * @brief Store a new value. Only one task may store values
+         *
+         * @param value the new value
+         */
+        void store(const T& value) {
+            std::array<std::uint32_t, WORDS> words;
+            std::memcpy(words.data(), &value, sizeof(T));
+            const std::uint32_t seq = sequence.load(std::memory_order_relaxed);
+            // an odd sequence number tells readers a write is in progress
+            sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WORDS; i++) data[i].store(words[i], std::memory_order_relaxed);
+            sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief Load the value. Can be called from any task, but not from an interrupt, since it sleeps while a
+         * write is stuck halfway
+         *
+         * @return T a consistent copy of the latest value
+         */
+        T load() const {
+            std::array<std::uint32_t, WORDS> words;
+            std::uint32_t before;
+            std::uint32_t after;
+            int spins = 0;
+            while (true) {
+                before = sequence.load(std::memory_order_acquire);
+                for (size_t i = 0; i < WORDS; i++) words[i] = data[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = sequence.load(std::memory_order_relaxed);
+                if (before == after && before % 2 == 0) break;
+                if (++spins >= MAX_SPINS) {
+                    pros::c::delay(1);
+                    spins = 0;
+                }
+            }
+            T value;
+            std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+            return value;
+        }
+    private:
+        std::atomic<std::uint32_t> sequence {0};
+        std::array<std::atomic<std::uint32_t>, WORDS> data {};
+};
+} // namespace robot
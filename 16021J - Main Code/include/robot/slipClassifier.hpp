@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+namespace robot {
+
+/**
+ * @brief Thresholds used by SlipDetector
+ *
+ * To tune, print the drive motor and tracking wheel distances while accelerating hard, turning in place and
+ * ramming a stake. The thresholds should sit above what normal driving produces
+ */
+struct SlipSettings {
+        /** the drive motors and tracking wheel disagree when their distances differ by more than this fraction of
+         * the larger one. 0.3 by default */
+        float distanceRatio = 0.3;
+        /** disagreements smaller than this are ignored, in inches per 10ms. 0.05 by default */
+        float minDistance = 0.05;
+        /** the drive motors and IMU disagree when their yaw rates differ by more than this, in degrees per second.
+         * Wheels scrub while turning, so this has to be fairly large. 90 by default */
+        float yawRateError = 90;
+        /** how long a detection is held after the disagreement stops, in ms. 250 by default */
+        int holdTime = 250;
+        /** how much the odometry noise of the pose estimators is scaled by while a detection is held. 10 by
+         * default */
+        float noiseScale = 10;
+};
+
+/**
+ * @brief The comparisons SlipDetector makes, on movements it is given instead of sensors it reads
+ *
+ * Kept apart from SlipDetector so it can be run on simulated or logged movements.
+ */
+class SlipClassifier {
+    public:
+        /**
+         * @brief Create a new slip classifier
+         *
+         * @param trackWidth the track width of the drivetrain, in inches
+         * @param verticalOffset the offset of the vertical tracking wheel, in inches
+         * @param settings detection thresholds
+         */
+        SlipClassifier(float trackWidth, float verticalOffset, SlipSettings settings = {});
+        /**
+         * @brief Compare the movement since the last update, and start or extend a detection if they disagree
+         *
+         * @param deltaLeft distance the left drive motors moved, in inches
+         * @param deltaRight distance the right drive motors moved, in inches
+         * @param deltaVertical distance the vertical tracking wheel moved, in inches
+         * @param deltaImu rotation measured by the IMU, in degrees. NAN if there is no IMU
+         * @param dt time since the last update, in seconds
+         * @param now the current time, in ms
+         */
+        void update(float deltaLeft, float deltaRight, float deltaVertical, float deltaImu, float dt,
+                    std::uint32_t now);
+        /**
+         * @brief Whether the drive wheels are slipping, or did within the hold time
+         *
+         * @param now the current time, in ms
+         */
+        bool isSlipping(std::uint32_t now) const;
+        /**
+         * @brief Whether the robot was hit, or was within the hold time
+         *
+         * @param now the current time, in ms
+         */
+        bool isColliding(std::uint32_t now) const;
+        /**
+         * @brief Get how many times the drive wheels started slipping
+         *
+         * @return int
+         */
+        int getSlipCount() const;
+        /**
+         * @brief Get how many collisions were detected
+         *
+         * @return int
+         */
+        int getCollisionCount() const;
+    private:
+        const float trackWidth;
+        const float verticalOffset;
+        const SlipSettings settings;
+
+        std::uint32_t slipUntil = 0;
+        std::uint32_t collisionUntil = 0;
+        int slipCount = 0;
+        int collisionCount = 0;
+};
+} // namespace robot
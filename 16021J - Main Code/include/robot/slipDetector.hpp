@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include "pros/imu.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "robot/slipClassifier.hpp"
+
+namespace robot {
+
+/**
+ * @brief Detects wheel slip and collisions by comparing the drive motors, tracking wheel and IMU
+ *
+ * Every 10ms the distance driven by the drive motor encoders is compared to the distance measured by the
+ * vertical tracking wheel, and the yaw rate implied by the drive motors is compared to the IMU:
+ * - the drive motors moving further or turning faster than the robot means the drive wheels are slipping,
+ *   like when accelerating hard or pushing against another robot
+ * - the robot moving or turning without the drive motors means something hit it, or the tracking wheel lost
+ *   contact with the field
+ *
+ * Each new detection is counted and sent to lemlib::telemetrySink(). While a detection is held,
+ * getOdomNoiseScale() tells PoseEstimator and ParticleFilter to trust odometry less, so the absolute sensors
+ * correct the pose faster. The comparisons themselves are made by SlipClassifier.
+ */
+class SlipDetector {
+    public:
+        /**
+         * @brief Create a new slip detector
+         *
+         * @param drivetrain the drivetrain, for its motors, wheel size and track width
+         * @param vertical the vertical tracking wheel
+         * @param imu the IMU, nullptr if there is none
+         * @param settings detection thresholds
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::SlipDetector slip_detector(drivetrain, &vertical_tracking_wheel, &imu);
+         *
+         * void initialize() {
+         *     slip_detector.start();
+         * }
+         * @endcode
+         */
+        SlipDetector(lemlib::Drivetrain drivetrain, lemlib::TrackingWheel* vertical, pros::Imu* imu,
+                     SlipSettings settings = {});
+        /**
+         * @brief Start updating the detector every 10ms in its own task
+         */
+        void start();
+        /**
+         * @brief Compare the sensors since the last update. Called by the task started with start()
+         */
+        void update();
+        /**
+         * @brief Whether the drive wheels are slipping, or did within the hold time
+         *
+         * @return true the drive wheels are slipping
+         * @return false the drive wheels are gripping
+         */
+        bool isSlipping() const;
+        /**
+         * @brief Whether the robot was hit, or was within the hold time
+         *
+         * @return true the robot moved without its drive motors
+         * @return false no collision
+         */
+        bool isColliding() const;
+        /**
+         * @brief Get how many times the drive wheels started slipping
+         *
+         * @return int
+         */
+        int getSlipCount() const;
+        /**
+         * @brief Get how many collisions were detected
+         *
+         * @return int
+         */
+        int getCollisionCount() const;
+        /**
+         * @brief Get how much odometry noise should be scaled by right now
+         *
+         * @return float settings.noiseScale while a detection is held, 1 otherwise
+         */
+        float getOdomNoiseScale() const;
+    private:
+        void resetBaseline();
+
+        const lemlib::Drivetrain drivetrain;
+        lemlib::TrackingWheel leftWheel;
+        lemlib::TrackingWheel rightWheel;
+        lemlib::TrackingWheel* vertical;
+        pros::Imu* imu;
+        const SlipSettings settings;
+        SlipClassifier classifier;
+
+        float prevLeft = 0;
+        float prevRight = 0;
+        float prevVertical = 0;
+        double prevRotation = 0;
+        std::uint32_t prevTime = 0;
+        bool hasBaseline = false;
+        pros::Task* task = nullptr;
+};
+} // namespace robot
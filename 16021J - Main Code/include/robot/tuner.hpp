@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include "pros/rtos.hpp"
+#include "robot/chassis.hpp"
+#include "robot/params.hpp"
+#include "robot/tuningLog.hpp"
+
+namespace robot {
+
+/**
+ * @brief Tune the lateral and angular controllers over the USB serial connection, without uploading again
+ *
+ * A task reads commands from stdin, one per line, and answers on stdout:
+ * - `get` prints the gains of both controllers, as `gains <controller> <kP> <kI> <kD> <windupRange>`
+ * - `set <lateral|angular> <kP> <kI> <kD> [windupRange]` changes the gains of a controller, and prints them. The
+ *   windup range is kept when it's left out
+ * - `test lateral <inches> [timeout]` drives straight forward, or backward for negative distances, with
+ *   moveToPoint
+ * - `test angular <degrees> [timeout]` turns in place with turnToHeading, clockwise for positive angles
+ *
+ * While a test runs, every tick of the controller being tested is printed as
+ * `sample <time ms> <error> <output> <velocity>`, followed by `done <time ms>` when the motion ends. Errors are
+ * printed as `error <message>`. tools/tune.py talks to this from a computer.
+ *
+ * If a ParamStore is given, `param` commands are passed to it, see ParamStore::handle.
+ *
+ * Gains are changed with Chassis::setLateralGains and Chassis::setAngularGains, so a change takes effect on the
+ * next tick of the running motion and never allocates. Tests only move the robot while it's enabled. Nothing
+ * else may drive the drivetrain while isTesting() is true.
+ */
+class Tuner {
+    public:
+        /**
+         * @brief Create a new tuner
+         *
+         * @param chassis the chassis to tune
+         * @param params parameters that can be changed and saved with `param` commands. nullptr by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::Tuner tuner(chassis, &params);
+         *
+         * void initialize() {
+         *     tuner.start();
+         * }
+         * @endcode
+         */
+        Tuner(Chassis& chassis, ParamStore* params = nullptr);
+        /**
+         * @brief Start reading commands in a task
+         */
+        void start();
+        /**
+         * @brief Run one command
+         *
+         * @param command the command, without the newline
+         */
+        void handle(const char* command);
+        /**
+         * @brief Whether a test motion is running, so driver control has to leave the drivetrain alone
+         *
+         * @return true a test is running
+         * @return false no test is running
+         */
+        bool isTesting() const;
+    private:
+        void printGains();
+        void test(bool lateral, float amount, int timeout);
+
+        Chassis& chassis;
+        ParamStore* params;
+        TuningLog log;
+        pros::Task* task = nullptr;
+        std::atomic<bool> testing = false;
+};
+} // namespace robot
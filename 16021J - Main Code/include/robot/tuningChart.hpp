@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "liblvgl/lvgl.h"
+#include "robot/tuningLog.hpp"
+
+namespace robot {
+
+/**
+ * @brief Which PID controller a TuningChart shows
+ */
+enum class TuningController { LATERAL, ANGULAR };
+
+/**
+ * @brief Settings for TuningChart
+ */
+struct TuningChartSettings {
+        /** the controller to show. Lateral by default */
+        TuningController controller = TuningController::LATERAL;
+        /** number of points across the chart. 200 by default */
+        std::uint16_t points = 200;
+        /** how many samples are averaged into each point. Motions record a sample every 10ms, so with 200
+         * points the chart shows 2 seconds times this. 1 by default */
+        int decimation = 1;
+        /** the error and velocity axis goes from -range to range, in inches or degrees. The output axis is
+         * always -127 to 127. 48 by default */
+        float range = 48;
+        /** time between chart updates, in milliseconds. 50 by default */
+        int period = 50;
+};
+
+/**
+ * @brief Live charts of the error, output and velocity of a PID controller on the brain screen
+ *
+ * Motions write a sample to the log every tick (see Chassis::setTuningLog), and the chart reads the log from an
+ * LVGL timer. The chart is in circular mode, so adding a point overwrites the oldest one in place instead of
+ * shifting every point, and only the area around the new point is redrawn. Tapping the chart pauses it, so a
+ * trace can be looked at after the motion is done, and tapping it again resumes it.
+ */
+class TuningChart {
+    public:
+        /**
+         * @brief Create a new tuning chart
+         *
+         * @param settings controller, window size and scale
+         *
+         * @b Example
+         * @code {.cpp}
+         * robot::TuningChart tuning_chart({.controller = robot::TuningController::ANGULAR, .range = 180});
+         *
+         * void initialize() {
+         *     chassis.setTuningLog(tuning_chart.getLog());
+         *     tuning_chart.start();
+         * }
+         * @endcode
+         */
+        TuningChart(TuningChartSettings settings = {});
+        /**
+         * @brief Get the log the chart reads from, to pass to Chassis::setTuningLog
+         *
+         * @return TuningLog*
+         */
+        TuningLog* getLog();
+        /**
+         * @brief Create the chart, load its screen and start updating it
+         */
+        void start();
+        /**
+         * @brief Pause or resume the chart. Samples recorded while paused are discarded
+         *
+         * @param paused true to pause, false to resume
+         */
+        void setPaused(bool paused);
+        /**
+         * @brief Whether the chart is paused
+         *
+         * @return true the chart is paused
+         * @return false the chart is live
+         */
+        bool isPaused() const;
+    private:
+        void update();
+
+        const TuningChartSettings settings;
+        TuningLog log;
+        std::atomic<bool> paused = false;
+
+        lv_obj_t* screen = nullptr;
+        lv_obj_t* chart = nullptr;
+        lv_obj_t* pausedLabel = nullptr;
+        lv_chart_series_t* errorSeries = nullptr;
+        lv_chart_series_t* outputSeries = nullptr;
+        lv_chart_series_t* velocitySeries = nullptr;
+        lv_timer_t* timer = nullptr;
+
+        // samples summed into the next point
+        float errorSum = 0;
+        float outputSum = 0;
+        float velocitySum = 0;
+        int count = 0;
+};
+} // namespace robot
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "robot/ringBuffer.hpp"
+
+namespace robot {
+
+/**
+ * @brief The state of the PID controllers during one tick of a motion
+ */
+struct TuningSample {
+        /** error of the lateral controller, in inches */
+        float lateralError;
+        /** output of the lateral controller, after limits, from -127 to 127 */
+        float lateralOutput;
+        /** error of the angular controller, in degrees */
+        float angularError;
+        /** output of the angular controller, after limits, from -127 to 127 */
+        float angularOutput;
+        /** speed of the robot, in inches per second */
+        float velocity;
+        /** turning speed of the robot, in degrees per second, clockwise is positive */
+        float angularVelocity;
+};
+
+/**
+ * @brief Queue of samples written by the motion task, see Chassis::setTuningLog
+ */
+using TuningLog = RingBuffer<TuningSample, 256>;
+} // namespace robot
@@ -1,24 +1,66 @@
 #include "main.h"
 #include "lemlib/api.hpp"
 #include "lemlib/chassis/trackingWheel.hpp"
+#include "robot/autonSelector.hpp"
+#include "robot/chassis.hpp"
+#include "robot/controllerDisplay.hpp"
+#include "robot/controllerSync.hpp"
+#include "robot/dashboard.hpp"
+#include "robot/displayMonitor.hpp"
+#include "robot/driveCurve.hpp"
+#include "robot/fusedImu.hpp"
+#include "robot/params.hpp"
+#include "robot/slipDetector.hpp"
+#include "robot/tuner.hpp"
+#include "robot/tuningChart.hpp"
 #include "pros/abstract_motor.hpp"
 #include "pros/misc.h"
 #include "pros/rtos.h"
 #include <cstdio>
 #include <math.h>
-#include <unordered_map>
 
 
 pros::Controller controller(pros::E_CONTROLLER_MASTER); //defined before keybinds because syntax :/
 
-//Map of all used keybinds for convinience of changing/adding new ones. (ty paul)
-static std::unordered_map<std::string, pros::controller_digital_e_t> buttonMap = {
-    {"Stake Lock", pros::E_CONTROLLER_DIGITAL_L1},
-    {"Conveyer Spin", pros::E_CONTROLLER_DIGITAL_R1},
-    {"Reverse Conveyer Spin", pros::E_CONTROLLER_DIGITAL_R2}
-};
-
-int intake_velocity = 127;
+//sends text to the controller screen from its own task, so printing never slows down the drive loop
+robot::ControllerDisplay controller_display(controller);
+
+//runs the drive loop every 10ms and applies new stick positions as soon as they arrive, latency is reported over
+//telemetry
+robot::ControllerSync controller_sync(controller, 10);
+
+//settings saved on the SD card, loaded in initialize(). list, change and save them over USB with
+//tools/tune.py param ..., no upload needed. bump the version when a setting changes meaning or units
+robot::ParamStore params(1);
+
+//all used keybinds, as parameters for convinience of changing/adding new ones. (ty paul)
+robot::Param<int> stake_lock_button(params, "button.stake_lock", pros::E_CONTROLLER_DIGITAL_L1);
+robot::Param<int> conveyer_button(params, "button.conveyer", pros::E_CONTROLLER_DIGITAL_R1);
+robot::Param<int> reverse_conveyer_button(params, "button.reverse_conveyer", pros::E_CONTROLLER_DIGITAL_R2);
+
+robot::Param<int> intake_velocity(params, "intake.velocity", 127);
+
+//where the robot starts autonomous
+robot::Param<float> start_x(params, "start.x", -55.5);
+robot::Param<float> start_y(params, "start.y", 12);
+robot::Param<float> start_theta(params, "start.theta", 270);
+
+//PID gains. `param set` applies them right away, the tuner's `set` only until the program restarts
+void apply_lateral_gains();
+void apply_angular_gains();
+robot::Param<float> lateral_kp(params, "lateral.kP", 10, apply_lateral_gains);
+robot::Param<float> lateral_ki(params, "lateral.kI", 0, apply_lateral_gains);
+robot::Param<float> lateral_kd(params, "lateral.kD", 3, apply_lateral_gains);
+robot::Param<float> lateral_windup(params, "lateral.windup", 3, apply_lateral_gains);
+robot::Param<float> angular_kp(params, "angular.kP", 2, apply_angular_gains);
+robot::Param<float> angular_ki(params, "angular.kI", 0, apply_angular_gains);
+robot::Param<float> angular_kd(params, "angular.kD", 10, apply_angular_gains);
+robot::Param<float> angular_windup(params, "angular.windup", 3, apply_angular_gains);
+
+//reads a keybind
+bool button_held(const robot::Param<int>& button) {
+    return controller.get_digital(static_cast<pros::controller_digital_e_t>(button.get()));
+}
 
 
 //pneumatic control
@@ -42,16 +84,16 @@ lemlib::Drivetrain drivetrain(&left_motor_group, // left motor group
                               2 // horizontal drift is 2 (for now)
 );
 
-// imu
-pros::Imu imu(11);
-// horizontal tracking wheel encoder
-pros::adi::Encoder horizontal_encoder('A', 'B', false);
-// vertical tracking wheel encoder
-pros::adi::Encoder vertical_encoder('G', 'H', false);
+// imu, fused so more IMUs can be added by listing their ports
+robot::FusedImu imu({11});
+// horizontal tracking wheel rotation sensor
+pros::Rotation horizontal_rotation(2);
+// vertical tracking wheel rotation sensor
+pros::Rotation vertical_rotation(3);
 // horizontal tracking wheel
-lemlib::TrackingWheel horizontal_tracking_wheel(&horizontal_encoder, lemlib::Omniwheel::NEW_275, 0);
+lemlib::TrackingWheel horizontal_tracking_wheel(&horizontal_rotation, lemlib::Omniwheel::NEW_275, 0);
 // vertical tracking wheel
-lemlib::TrackingWheel vertical_tracking_wheel(&vertical_encoder, lemlib::Omniwheel::NEW_275, 0);
+lemlib::TrackingWheel vertical_tracking_wheel(&vertical_rotation, lemlib::Omniwheel::NEW_275, 0);
 
 // odometry settings
 lemlib::OdomSensors sensors(&vertical_tracking_wheel, // vertical tracking wheel 1, set to null
@@ -62,10 +104,10 @@ lemlib::OdomSensors sensors(&vertical_tracking_wheel, // vertical tracking wheel
 );
 
 // lateral PID controller
-lemlib::ControllerSettings lateral_controller(10, // proportional gain (kP)
-                                              0, // integral gain (kI)
-                                              3, // derivative gain (kD)
-                                              3, // anti windup
+lemlib::ControllerSettings lateral_controller(lateral_kp, // proportional gain (kP)
+                                              lateral_ki, // integral gain (kI)
+                                              lateral_kd, // derivative gain (kD)
+                                              lateral_windup, // anti windup
                                               1, // small error range, in inches
                                               100, // small error range timeout, in milliseconds
                                               3, // large error range, in inches
@@ -74,10 +116,10 @@ lemlib::ControllerSettings lateral_controller(10, // proportional gain (kP)
 );
 
 // angular PID controller
-lemlib::ControllerSettings angular_controller(2, // proportional gain (kP)
-                                              0, // integral gain (kI)
-                                              10, // derivative gain (kD)
-                                              3, // anti windup
+lemlib::ControllerSettings angular_controller(angular_kp, // proportional gain (kP)
+                                              angular_ki, // integral gain (kI)
+                                              angular_kd, // derivative gain (kD)
+                                              angular_windup, // anti windup
                                               1, // small error range, in degrees
                                               100, // small error range timeout, in milliseconds
                                               3, // large error range, in degrees
@@ -85,21 +127,59 @@ lemlib::ControllerSettings angular_controller(2, // proportional gain (kP)
                                               0 // maximum acceleration (slew)
 );
 
+// joystick curves, worked out for every stick position at startup. no deadband and linear, like LemLib's default
+robot::TableDriveCurve throttle_curve(0, // joystick deadband out of 127
+                                      0, // minimum output where drivetrain will move out of 127
+                                      1 // expo curve gain
+);
+robot::TableDriveCurve steer_curve(0, // joystick deadband out of 127
+                                   0, // minimum output where drivetrain will move out of 127
+                                   1 // expo curve gain
+);
+
 // create the chassis
-lemlib::Chassis chassis(drivetrain, // drivetrain settings
+robot::Chassis chassis(drivetrain, // drivetrain settings
                         lateral_controller, // lateral PID settings
                         angular_controller, // angular PID settings
-                        sensors // odometry sensors
+                        sensors, // odometry sensors
+                        &throttle_curve, // throttle curve
+                        &steer_curve // steer curve
 );
 
+// compares the drive motors, tracking wheel and imu to catch wheel slip and collisions
+robot::SlipDetector slip_detector(drivetrain, &vertical_tracking_wheel, &imu);
+
+// brain screen dashboard, only redraws what changed
+robot::Dashboard dashboard(chassis);
+
+// measures how long the brain screen takes to draw, reported over telemetry
+robot::DisplayMonitor display_monitor;
+
+// set and test PID gains over USB without uploading again, see tools/tune.py. also changes the parameters
+robot::Tuner tuner(chassis, &params);
+
+void apply_lateral_gains() { chassis.setLateralGains({lateral_kp, lateral_ki, lateral_kd, lateral_windup}); }
+
+void apply_angular_gains() { chassis.setAngularGains({angular_kp, angular_ki, angular_kd, angular_windup}); }
+
+// live PID charts for tuning lateral_controller, shown instead of the dashboard when this is true
+constexpr bool show_tuning_chart = false;
+robot::TuningChart tuning_chart;
+
+// autonomous selector on the dashboard, sets up the selected routine while the robot is disabled
+robot::AutonSelector auton_selector(chassis);
+
+// autonomous routines, defined with the other autonomous code below
+void stake_auton(const std::vector<robot::Path>& paths);
 
 //ran as a task; enables or disables the stake lock upon button press
 void toggle_stake_lock(){
     static bool pressed = false;
     while (true){
-        if(controller.get_digital(buttonMap["Stake Lock"])){
+        if(button_held(stake_lock_button)){
             pressed = !pressed;
             stake_lock.set_value(pressed);
+            controller_display.setLine(0, "Stake: %s", pressed ? "locked" : "open");
 
             pros::c::delay(250);
         }
@@ -110,10 +190,10 @@ void toggle_stake_lock(){
 void conveyer_spin(){
     //static bool pressed = false;
     while(true){
-        if(controller.get_digital(buttonMap["Conveyer Spin"])){
+        if(button_held(conveyer_button)){
             intake_motor1.move(intake_velocity);
             intake_motor2.move(intake_velocity);
-        } else if(controller.get_digital(buttonMap["Reverse Conveyer Spin"])){
+        } else if(button_held(reverse_conveyer_button)){
             intake_motor1.move(-intake_velocity);
             intake_motor2.move(-intake_velocity);
         } else{
@@ -124,23 +204,69 @@ void conveyer_spin(){
     }
 }
 
+//ran as a task; shows the battery and hottest motor on the controller, and warns the driver when they get bad
+void driver_alerts(){
+    bool was_hot = false;
+    bool was_low = false;
+    while(true){
+        double hottest = 0;
+        for(pros::MotorGroup* group : {&left_motor_group, &right_motor_group}){
+            for(int i = 0; i < group->size(); i++){
+                const double temperature = group->get_temperature(i);
+                if(std::isfinite(temperature) && temperature > hottest) hottest = temperature;
+            }
+        }
+        for(pros::Motor* motor : {&intake_motor1, &intake_motor2}){
+            const double temperature = motor->get_temperature();
+            if(std::isfinite(temperature) && temperature > hottest) hottest = temperature;
+        }
+        const double battery = pros::battery::get_capacity();
+        controller_display.setLine(1, "Bat %.0f%% %.0fC", battery, hottest);
+
+        //motors start losing power at 55C. only rumble when it starts, not every time it's checked
+        const bool hot = hottest >= 55;
+        const bool low = battery < 20;
+        if(hot) controller_display.alert("MOTORS HOT", 1000, was_hot ? nullptr : "--");
+        else if(low) controller_display.alert("LOW BATTERY", 1000, was_low ? nullptr : ".");
+        was_hot = hot;
+        was_low = low;
+
+        pros::c::delay(500);
+    }
+}
+
 // initialize function. Runs on program startup
 void initialize() {
-    pros::lcd::initialize(); // initialize brain screen
-    chassis.calibrate(); // calibrate sensors
-    chassis.setPose(-55.5, 12, 270);// set chassis pose
-
-    // print position to brain screen
-    pros::Task screen_task([&]() {
-        while (true) {
-            // print robot location to the brain screen
-            pros::lcd::print(0, "X: %f", chassis.getPose().x); // x
-            pros::lcd::print(1, "Y: %f", chassis.getPose().y); // y
-            pros::lcd::print(2, "Theta: %f", chassis.getPose().theta); // heading
-            // delay to save resources
-            pros::delay(25);
-        }
-    });
+    params.load(); // saved settings replace the defaults, if there's an SD card with a valid save
+    // rotation sensors report every 5ms instead of the default 10ms, so odometry can update twice as often
+    horizontal_rotation.set_data_rate(5);
+    vertical_rotation.set_data_rate(5);
+    imu.set_data_rate(5); // and so does the imu, otherwise every other update would use an old heading
+    imu.setMotors(&left_motor_group, &right_motor_group); // only learn the imu drift while the drive is still
+    chassis.calibrateAsync(true, 5); // calibrate sensors in the background, then update odometry every 5ms
+    slip_detector.start(); // count slips and collisions, reported over telemetry
+    controller_display.start(); // controller screen, updated from a low priority task
+    tuner.start(); // reads tuning commands sent over USB
+    controller_display.setLine(0, "Stake: open");
+    pros::Task driver_alerts_task(driver_alerts); // started once here, opcontrol can run more than once per match
+
+    // show the field, pose, battery and motor temperatures on the brain screen
+    dashboard.addMotors("Left drive", &left_motor_group);
+    dashboard.addMotors("Right drive", &right_motor_group);
+    dashboard.start();
+    display_monitor.start();
+
+    // register the autonomous routines with their start poses, and get the first one ready
+    const lemlib::Pose start(start_x, start_y, start_theta);
+    auton_selector.add("Stake", start, stake_auton);
+    auton_selector.add("Do nothing", start, [](const std::vector<robot::Path>&) {});
+    auton_selector.select(0);
+    auton_selector.create(dashboard.getScreen(), 240, 185, 220);
+
+    if (show_tuning_chart) {
+        chassis.setTuningLog(tuning_chart.getLog()); // moveToPoint and moveToPose record every tick
+        tuning_chart.start();
+    }
 }
 
 
@@ -217,9 +343,8 @@ void auto_conveyer_spin(int velocity){
     }
 }
 
-//starting position for autonomous is found in initialization()
-void autonomous() {
-    
+//starting position is set by the autonomous selector, registered in initialize()
+void stake_auton(const std::vector<robot::Path>&) {
     //positioning for driving into stake(backwards because the stake latch is on the back of the robot)
     chassis.moveToPose(-46, 12, 270, 1500, {.forwards=false});
     chassis.waitUntilDone(); //not really sure if this works, but it ensures that only one command is run at a time.
@@ -228,9 +353,8 @@ void autonomous() {
     chassis.turnToPoint(-24, 24, 1500, {.forwards=false});
     chassis.waitUntilDone(); //not really sure if this works, but it ensures that only one command is run at a time.
 
-    //drive backwards into stake
-    chassis.tank(-127,-127); //drive backwards at full speed using lemlib function
-    pros::c::delay(300);
+    //drive backwards into stake, stops pushing as soon as the robot hits it (or after 300ms, like before)
+    chassis.tankUntilContact(-127,-127, 300);
 
     stake_lock.set_value(1); //enables stake lock
     pros::c::delay(250);
@@ -238,6 +362,11 @@ void autonomous() {
 
     auto_conveyer_spin(127); //TEMP; just to show formatting for future use
 }
+
+void autonomous() {
+    chassis.waitUntilCalibrated(); //don't move until odometry is running
+    auton_selector.run(); //paths were parsed and the pose was set when the routine was selected
+}
 /**
  * Runs the operator control code. This function will be started in its own task
  * with the default priority and stack size whenever the robot is enabled via
@@ -253,20 +382,23 @@ void autonomous() {
  */
 
 void opcontrol() {
+    //a motion left over from autonomous keeps running in its own task, stop it so the driver has control
+    chassis.cancelAllMotions();
+
     //individual inputs are ran on a seperate task, this makes the task run (almost) instantly and at the same time
     pros::Task stake_lock_task(toggle_stake_lock);
     pros::Task conveyer_spin_task(conveyer_spin);
 
     // loop forever
     while (true) {
-        // get left y and right x positions
-        int leftY = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
-        int rightX = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
-
-        // move the robot
-        chassis.arcade(leftY, rightX);
-
-        // delay to save resources
-        pros::delay(25);
+        // wait for the next tick, then get the stick positions
+        controller_sync.wait();
+        const robot::Sticks sticks = controller_sync.getSticks();
+
+        // move the robot, unless a tuning test is running
+        if (!tuner.isTesting()) {
+            chassis.arcade(sticks.leftY, sticks.rightX);
+            controller_sync.applied();
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <mutex>
+#include <string>
+#include "robot/autonSelector.hpp"
+
+namespace robot {
+
+AutonSelector::AutonSelector(Chassis& chassis)
+    : chassis(chassis) {}
+
+size_t AutonSelector::add(const char* name, lemlib::Pose start, Routine routine,
+                          std::initializer_list<const asset*> paths) {
+    entries.push_back({name, start, std::move(routine), paths});
+    return entries.size() - 1;
+}
+
+void AutonSelector::create(lv_obj_t* parent, lv_coord_t x, lv_coord_t y, lv_coord_t width) {
+    if (dropdown != nullptr) return;
+    std::string options;
+    for (const Entry& entry : entries) {
+        if (!options.empty()) options += '\n';
+        options += entry.name;
+    }
+    dropdown = lv_dropdown_create(parent);
+    lv_obj_set_pos(dropdown, x, y);
+    lv_obj_set_width(dropdown, width);
+    lv_dropdown_set_options(dropdown, options.c_str());
+    if (selected >= 0) lv_dropdown_set_selected(dropdown, selected);
+    lv_obj_add_event_cb(
+        dropdown,
+        [](lv_event_t* event) {
+            AutonSelector* selector = static_cast<AutonSelector*>(lv_event_get_user_data(event));
+            // put the dropdown back if the selection is locked
+            if (!selector->select(lv_dropdown_get_selected(selector->dropdown)) && selector->selected >= 0)
+                lv_dropdown_set_selected(selector->dropdown, selector->selected);
+        },
+        LV_EVENT_VALUE_CHANGED, this);
+}
+
+bool AutonSelector::select(size_t index) {
+    if (index >= entries.size() || locked) return false;
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (locked) return false;
+    if (selected == static_cast<int>(index)) return true;
+    // do all of the setup now, so autonomous doesn't have to
+    const Entry& entry = entries[index];
+    paths.clear();
+    paths.reserve(entry.assets.size());
+    for (const asset* path : entry.assets) paths.emplace_back(*path);
+    chassis.setPose(entry.start);
+    selected = index;
+    return true;
+}
+
+int AutonSelector::getSelected() const { return selected; }
+
+void AutonSelector::run() {
+    locked = true;
+    // wait for a selection that's still being prepared
+    { std::lock_guard<pros::Mutex> lock(mutex); }
+    if (selected < 0) return;
+    // set the pose again, in case the robot was moved into place after it was selected
+    chassis.setPose(entries[selected].start);
+    entries[selected].routine(paths);
+}
+} // namespace robot
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/util.hpp"
+#include "robot/chassis.hpp"
+
+// number of points the boomerang curve is solved into. Bounds the work done every tick
+constexpr size_t BOOMERANG_POINTS = 32;
+
+void robot::Chassis::boomerang(float x, float y, float theta, int timeout, BoomerangParams params, bool async) {
+    boomerang(x, y, theta, timeout, params, {}, async);
+}
+
+void robot::Chassis::boomerang(float x, float y, float theta, int timeout, BoomerangParams params, Markers markers,
+                               bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, x, y, theta, timeout, params, markers]() {
+            boomerang(x, y, theta, timeout, params, markers, false);
+        });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // the direction the robot travels in at the start and at the end of the motion, in standard position
+    const lemlib::Pose start = this->getPose(true, true);
+    const float startHeading = params.forwards ? start.theta : start.theta + M_PI;
+    const float targetHeading = M_PI_2 - lemlib::degToRad(theta) + (params.forwards ? 0 : M_PI);
+    const lemlib::Pose target(x, y);
+    const float dist = start.distance(target);
+
+    // the carrot point is where lemlib::Chassis::moveToPose would aim at the start of the motion.
+    // The second control point keeps the curve tangent to the robot, since it can't turn instantly
+    const lemlib::Pose p0 = start;
+    const lemlib::Pose p1 =
+        start + lemlib::Pose(std::cos(startHeading), std::sin(startHeading)) * (dist * params.lead / 3);
+    const lemlib::Pose p2 =
+        target - lemlib::Pose(std::cos(targetHeading), std::sin(targetHeading)) * (dist * params.lead);
+    const lemlib::Pose p3 = target;
+
+    // sample the cubic bezier
+    std::vector<PathPoint> points;
+    points.reserve(BOOMERANG_POINTS);
+    for (size_t i = 0; i < BOOMERANG_POINTS; i++) {
+        const float t = float(i) / (BOOMERANG_POINTS - 1);
+        const float u = 1 - t;
+        const lemlib::Pose p = p0 * (u * u * u) + p1 * (3 * u * u * t) + p2 * (3 * u * t * t) + p3 * (t * t * t);
+        points.push_back({p.x, p.y, 0, 0, 0});
+    }
+    Path path(std::move(points));
+
+    // plan the speed along the curve, in inches per second
+    const float topSpeed = maxVelocity();
+    const float maxSpeed = params.maxSpeed / 127 * topSpeed;
+    const float minSpeed = params.minSpeed / 127 * topSpeed;
+    const float drift = params.horizontalDrift != 0 ? params.horizontalDrift : drivetrain.horizontalDrift;
+    std::vector<PathPoint> profiled;
+    profiled.reserve(BOOMERANG_POINTS);
+    for (size_t i = 0; i < path.size(); i++) {
+        PathPoint point = path[i];
+        const float accelLimit = std::sqrt(minSpeed * minSpeed + 2 * params.maxAccel * point.distance);
+        const float decelLimit =
+            std::sqrt(minSpeed * minSpeed + 2 * params.maxAccel * (path.length() - point.distance));
+        float speed = std::min({maxSpeed, accelLimit, decelLimit});
+        // limit the speed around corners, the same way lemlib::Chassis::moveToPose does
+        if (drift != 0 && point.curvature != 0) {
+            const float slipSpeed = std::sqrt(drift * (1 / std::fabs(point.curvature)) * 9.8) / 127 * topSpeed;
+            speed = std::min(speed, slipSpeed);
+        }
+        // the robot has to keep moving until the last point, otherwise it would stop short of the target
+        if (i + 1 < path.size()) speed = std::max(speed, 0.15f * topSpeed);
+        point.speed = speed / topSpeed * 127;
+        profiled.push_back(point);
+    }
+    profiled.back().speed = params.minSpeed;
+
+    FollowParams followParams;
+    followParams.forwards = params.forwards;
+    followParams.earlyExitRange = params.earlyExitRange;
+    track(Path(std::move(profiled)), timeout, followParams, markers);
+}
@@ -0,0 +1,95 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/util.hpp"
+#include "robot/chassis.hpp"
+#include "robot/fit.hpp"
+
+namespace {
+
+// time to let the robot settle after each turn before sampling, in ms
+constexpr int SETTLE_TIME = 150;
+
+/**
+ * @brief Wait for the robot to be pushed, and return how far the wheel went
+ */
+float waitForPush(lemlib::TrackingWheel* wheel) {
+    const float start = wheel->getDistanceTraveled();
+    // wait for the push to start
+    while (std::fabs(wheel->getDistanceTraveled() - start) < 1) pros::delay(10);
+    // then for the robot to be still for a second
+    float last = wheel->getDistanceTraveled();
+    std::uint32_t stillSince = pros::millis();
+    while (pros::millis() - stillSince < 1000) {
+        const float current = wheel->getDistanceTraveled();
+        if (std::fabs(current - last) > 0.05) {
+            last = current;
+            stillSince = pros::millis();
+        }
+        pros::delay(10);
+    }
+    return std::fabs(last - start);
+}
+
+void printFit(const char* name, const robot::TrackingWheelFit& fit) {
+    if (!fit.valid) {
+        std::printf("%s tracking wheel: not calibrated\n", name);
+        return;
+    }
+    std::printf("%s tracking wheel: offset %.3f in, diameter x%.4f, r^2 %.5f\n", name, fit.offset, fit.diameterScale,
+                fit.rSquared);
+    std::printf("    lemlib::TrackingWheel(&sensor, diameter * %.4f, %.3f)\n", fit.diameterScale, fit.offset);
+}
+} // namespace
+
+robot::TrackingWheelCalibration robot::Chassis::calibrateTrackingWheels(int spins, float pushDistance) {
+    TrackingWheelCalibration result;
+    if (sensors.imu == nullptr) {
+        std::printf("tracking wheel calibration needs an IMU\n");
+        return result;
+    }
+    lemlib::TrackingWheel* wheels[2] = {sensors.vertical1, sensors.horizontal1};
+    TrackingWheelFit* fits[2] = {&result.vertical, &result.horizontal};
+
+    // spin 90 degrees at a time, recording the rotation and wheel distances when the robot is still
+    std::vector<float> angles;
+    std::vector<float> distances[2];
+    auto sample = [&] {
+        pros::delay(SETTLE_TIME);
+        angles.push_back(lemlib::degToRad(sensors.imu->get_rotation()));
+        for (int i = 0; i < 2; i++) {
+            if (wheels[i] != nullptr) distances[i].push_back(wheels[i]->getDistanceTraveled());
+        }
+    };
+    sample();
+    float heading = getPose().theta;
+    for (int spin = 0; spin < spins; spin++) {
+        // alternate directions so any drift of the center of rotation cancels out
+        const bool clockwise = spin % 2 == 0;
+        for (int quarter = 0; quarter < 4; quarter++) {
+            heading += clockwise ? 90 : -90;
+            turnToHeading(heading, 2000,
+                          {.direction = clockwise ? lemlib::AngularDirection::CW_CLOCKWISE
+                                                  : lemlib::AngularDirection::CCW_COUNTERCLOCKWISE},
+                          false);
+            sample();
+        }
+    }
+
+    // the offsets scale with the real wheel diameter, which pushing the robot a known distance measures
+    const char* directions[2] = {"forward", "to the right"};
+    for (int i = 0; i < 2; i++) {
+        if (wheels[i] == nullptr || distances[i].size() != angles.size()) continue;
+        float pushed = 0;
+        if (pushDistance > 0) {
+            std::printf("push the robot straight %s %.1f inches\n", directions[i], pushDistance);
+            pushed = waitForPush(wheels[i]);
+        }
+        *fits[i] = fitTrackingWheel(angles.data(), distances[i].data(), angles.size(), pushDistance, pushed);
+    }
+
+    printFit("vertical", result.vertical);
+    printFit("horizontal", result.horizontal);
+    return result;
+}
@@ -0,0 +1,170 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/util.hpp"
+#include "robot/chassis.hpp"
+#include "robot/fit.hpp"
+#include "robot/odom.hpp"
+
+namespace {
+
+// LemLib's slip formula uses this for gravity, even though distances are in inches
+constexpr float GRAVITY = 9.8;
+// the robot is sliding once its sideways speed grows by this fraction of its forward speed
+constexpr float MAX_SIDEWAYS_RATIO = 0.1;
+// speeds of the outer side of the drivetrain for the arcs, and the ratio of the inner side
+constexpr int ARC_POWERS[] = {50, 70, 90, 110, 127};
+constexpr float ARC_RATIO = 0.5;
+// time the robot is given to reach a steady speed in an arc, then the time it is measured for, in ms
+constexpr int ARC_SETTLE_TIME = 700;
+constexpr int ARC_MEASURE_TIME = 500;
+// time between patterns for the robot to stop, in ms
+constexpr int STOP_TIME = 500;
+} // namespace
+
+robot::DrivetrainCharacterization robot::Chassis::characterizeDrivetrain() {
+    DrivetrainCharacterization result;
+    if (sensors.imu == nullptr) {
+        std::printf("drivetrain characterization needs an IMU\n");
+        return result;
+    }
+    // distances from the drive motor encoders, using the configured wheel diameter
+    lemlib::TrackingWheel left(drivetrain.leftMotors, drivetrain.wheelDiameter, -drivetrain.trackWidth / 2,
+                               drivetrain.rpm);
+    lemlib::TrackingWheel right(drivetrain.rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2,
+                                drivetrain.rpm);
+    auto rotation = [&] { return float(lemlib::degToRad(sensors.imu->get_rotation())); };
+    auto motorForward = [&] { return (left.getDistanceTraveled() + right.getDistanceTraveled()) / 2; };
+    auto motorDifference = [&] { return left.getDistanceTraveled() - right.getDistanceTraveled(); };
+    auto stop = [&] {
+        tank(0, 0, true);
+        pros::delay(STOP_TIME);
+    };
+
+    // wheel diameter, against the vertical tracking wheel
+    lemlib::TrackingWheel* vertical = sensors.vertical1;
+    float diameterScale = 1;
+    if (vertical != nullptr && vertical->getType() == 0) {
+        // distance of the tracking center, with the distance the wheel travels from turning removed
+        auto trackedForward = [&] { return vertical->getDistanceTraveled() + vertical->getOffset() * rotation(); };
+        std::vector<float> motor;
+        std::vector<float> tracked;
+        const float motorStart = motorForward();
+        const float trackedStart = trackedForward();
+        tank(60, 60, true);
+        for (std::uint32_t start = pros::millis(); pros::millis() - start < 1200; pros::delay(10)) {
+            motor.push_back(motorForward() - motorStart);
+            tracked.push_back(trackedForward() - trackedStart);
+        }
+        stop();
+        const LineFit line = fitLine(motor.data(), tracked.data(), motor.size());
+        diameterScale = line.slope;
+        result.wheelDiameter = drivetrain.wheelDiameter * diameterScale;
+        result.wheelDiameterRSquared = line.rSquared;
+
+        // check the fit driving back at a different speed
+        const float motorBack = motorForward();
+        const float trackedBack = trackedForward();
+        tank(-40, -40, true);
+        pros::delay(1500);
+        stop();
+        const float actual = trackedForward() - trackedBack;
+        const float predicted = (motorForward() - motorBack) * diameterScale;
+        if (actual != 0) result.wheelDiameterError = std::fabs(predicted - actual) / std::fabs(actual);
+    }
+
+    // track width: the difference between the sides is the track width times the angle turned
+    {
+        std::vector<float> angles;
+        std::vector<float> differences;
+        const float rotationStart = rotation();
+        const float differenceStart = motorDifference();
+        tank(50, -50, true);
+        for (std::uint32_t start = pros::millis();
+             std::fabs(rotation() - rotationStart) < 4 * M_PI && pros::millis() - start < 8000; pros::delay(10)) {
+            angles.push_back(rotation() - rotationStart);
+            differences.push_back((motorDifference() - differenceStart) * diameterScale);
+        }
+        stop();
+        const LineFit line = fitLine(angles.data(), differences.data(), angles.size());
+        result.trackWidth = line.slope;
+        result.trackWidthRSquared = line.rSquared;
+
+        // check the fit spinning the other way at a different speed
+        const float rotationBack = rotation();
+        const float differenceBack = motorDifference();
+        tank(-35, 35, true);
+        const std::uint32_t start = pros::millis();
+        while (std::fabs(rotation() - rotationBack) < 2 * M_PI && pros::millis() - start < 8000) pros::delay(10);
+        stop();
+        const float actual = rotation() - rotationBack;
+        if (actual != 0 && result.trackWidth != 0) {
+            const float predicted = (motorDifference() - differenceBack) * diameterScale / result.trackWidth;
+            result.trackWidthError = std::fabs(predicted - actual) / std::fabs(actual);
+        }
+    }
+
+    // horizontal drift: drive faster and faster arcs until the robot slides sideways
+    if (sensors.horizontal1 != nullptr) {
+        float baselineRatio = NAN;
+        for (const int power : ARC_POWERS) {
+            tank(power, power * ARC_RATIO, true);
+            pros::delay(ARC_SETTLE_TIME);
+            // speeds in the frame of the robot, from odometry
+            const lemlib::Pose startPose = robot::getPose(true);
+            const float rotationStart = rotation();
+            float forward = 0;
+            float sideways = 0;
+            lemlib::Pose prevPose = startPose;
+            for (std::uint32_t start = pros::millis(); pros::millis() - start < ARC_MEASURE_TIME; pros::delay(10)) {
+                const lemlib::Pose pose = robot::getPose(true);
+                const float dx = pose.x - prevPose.x;
+                const float dy = pose.y - prevPose.y;
+                const float heading = (pose.theta + prevPose.theta) / 2;
+                forward += dx * std::sin(heading) + dy * std::cos(heading);
+                sideways += dx * std::cos(heading) - dy * std::sin(heading);
+                prevPose = pose;
+            }
+            const float turned = rotation() - rotationStart;
+            stop();
+            if (forward <= 0 || turned == 0) continue;
+
+            // a tracking center that isn't on the drive axle moves sideways in an arc even without sliding, so
+            // compare against the slowest arc
+            const float ratio = std::fabs(sideways / forward);
+            if (std::isnan(baselineRatio)) baselineRatio = ratio;
+            if (ratio - baselineRatio > MAX_SIDEWAYS_RATIO) {
+                result.driftLimitFound = true;
+                break;
+            }
+            // LemLib compares sqrt(horizontalDrift * radius * 9.8) to the motor power, so the speed has to be on
+            // the same 0 to 127 scale, not in inches per second
+            const float speed = forward / (ARC_MEASURE_TIME / 1000.0f) / maxVelocity() * 127;
+            const float radius = std::fabs(forward / turned);
+            result.horizontalDrift = std::fmax(result.horizontalDrift, speed * speed / (radius * GRAVITY));
+        }
+    }
+
+    // report
+    std::printf("drivetrain characterization:\n");
+    std::printf("    track width: %.2f in, r^2 %.5f, %.1f%% error on the check spin\n", result.trackWidth,
+                result.trackWidthRSquared, result.trackWidthError * 100);
+    if (result.wheelDiameter > 0) {
+        std::printf("    wheel diameter: %.3f in, r^2 %.5f, %.1f%% error on the check drive\n", result.wheelDiameter,
+                    result.wheelDiameterRSquared, result.wheelDiameterError * 100);
+    } else {
+        std::printf("    wheel diameter: not measured, there is no vertical tracking wheel\n");
+    }
+    if (sensors.horizontal1 == nullptr) {
+        std::printf("    horizontal drift: not measured, there is no horizontal tracking wheel\n");
+    } else {
+        std::printf("    horizontal drift: %.1f, %s\n", result.horizontalDrift,
+                    result.driftLimitFound ? "the robot slid on faster arcs" : "a lower bound, the robot never slid");
+    }
+    const float diameter = result.wheelDiameter > 0 ? result.wheelDiameter : drivetrain.wheelDiameter;
+    const float drift = result.horizontalDrift > 0 ? result.horizontalDrift : drivetrain.horizontalDrift;
+    std::printf("    lemlib::Drivetrain(&left_motors, &right_motors, %.2f, %.3f, %.0f, %.1f)\n", result.trackWidth,
+                diameter, drivetrain.rpm, drift);
+    return result;
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include "pros/misc.h"
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/timer.hpp"
+#include "robot/chassis.hpp"
+#include "robot/odom.hpp"
+
+void robot::Chassis::calibrateAsync(bool calibrateIMU, int odomPeriod) {
+    if (calibrationTask != nullptr) return;
+    // start calibrating the IMU first, since it takes the longest
+    if (sensors.imu != nullptr && calibrateIMU) sensors.imu->reset(false);
+    // tracking wheels reset instantly. Use the drive motors for any that are missing, like calibrate() does
+    if (sensors.vertical1 == nullptr)
+        sensors.vertical1 = new lemlib::TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                                      -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    if (sensors.vertical2 == nullptr)
+        sensors.vertical2 = new lemlib::TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                                      drivetrain.trackWidth / 2, drivetrain.rpm);
+    sensors.vertical1->reset();
+    sensors.vertical2->reset();
+    if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+    if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+
+    calibrationTask = new pros::Task {[this, calibrateIMU, odomPeriod] {
+        if (sensors.imu != nullptr && calibrateIMU) {
+            for (int attempt = 1; attempt <= 5; attempt++) {
+                if (attempt > 1) sensors.imu->reset(false);
+                do pros::delay(10);
+                while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+                if (std::isfinite(sensors.imu->get_heading())) break;
+                // indicate error
+                pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
+                if (attempt == 5) sensors.imu = nullptr;
+            }
+        }
+        lemlib::setSensors(sensors, drivetrain);
+        robot::startOdom(odomPeriod);
+        calibrationTime = pros::millis();
+        calibrated = true;
+        pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+    }};
+}
+
+void robot::Chassis::setPose(float x, float y, float theta, bool radians) {
+    robot::setPose({x, y, theta}, radians);
+}
+
+void robot::Chassis::setPose(lemlib::Pose pose, bool radians) { robot::setPose(pose, radians); }
+
+lemlib::Pose robot::Chassis::getPose(bool radians, bool standardPos) {
+    return robot::getPose(radians, standardPos);
+}
+
+void robot::Chassis::calibrate(bool calibrateIMU) {
+    calibrateAsync(calibrateIMU);
+    waitUntilCalibrated();
+}
+
+bool robot::Chassis::isCalibrated() const { return calibrated; }
+
+bool robot::Chassis::waitUntilCalibrated(int timeout) const {
+    const uint32_t start = pros::millis();
+    while (!calibrated) {
+        if (timeout >= 0 && pros::millis() - start >= uint32_t(timeout)) return false;
+        pros::delay(10);
+    }
+    return true;
+}
+
+int robot::Chassis::getCalibrationTime() const { return calibrated ? calibrationTime : -1; }
+
+uint32_t robot::Chassis::getPredictedEndTime() const { return predictedEnd; }
+
+bool robot::Chassis::tankUntilContact(int left, int right, int timeout, ContactSettings settings) {
+    ContactDetector contact(drivetrain.leftMotors, drivetrain.rightMotors, settings);
+    lemlib::Timer timer(timeout);
+    this->tank(left, right);
+    while (!timer.isDone()) {
+        if (contact.update()) return true;
+        pros::delay(10);
+    }
+    return false;
+}
+
+float robot::Chassis::getRemainingDistance() const {
+    if (!this->isInMotion()) return 0;
+    const Progress current = progress.load();
+    if (!current.known) return -1;
+    return current.remainingDistance;
+}
+
+int robot::Chassis::getMotionETA() const {
+    if (!this->isInMotion()) return 0;
+    const Progress current = progress.load();
+    if (!current.known) return -1;
+    // path based motions know how fast they are going to drive
+    if (current.plannedTimeLeft >= 0) return current.plannedTimeLeft * 1000;
+    // otherwise assume the robot keeps its current speed
+    const lemlib::Pose speed = robot::getSpeed();
+    const float velocity = std::max(std::hypot(speed.x, speed.y), maxVelocity() / 4);
+    return current.remainingDistance / velocity * 1000;
+}
+
+float robot::Chassis::maxVelocity() const { return drivetrain.rpm / 60 * M_PI * drivetrain.wheelDiameter; }
+
+void robot::Chassis::setProgress(float distance, float plannedTime) { progress.store({distance, plannedTime, true}); }
+
+void robot::Chassis::clearProgress() { progress.store({}); }
+
+int robot::Chassis::getActivePathVersion() const { return activePathVersion; }
+
+int robot::Chassis::copyActivePath(std::vector<PathPoint>& points) {
+    std::lock_guard<pros::Mutex> lock(activePathMutex);
+    points.clear();
+    if (activePath != nullptr) {
+        points.reserve(activePath->size());
+        for (size_t i = 0; i < activePath->size(); i++) points.push_back((*activePath)[i]);
+    }
+    return activePathVersion;
+}
+
+void robot::Chassis::setActivePath(const Path* path) {
+    std::lock_guard<pros::Mutex> lock(activePathMutex);
+    activePath = path;
+    activePathVersion++;
+}
+
+void robot::Chassis::setTuningLog(TuningLog* log) { tuningLog = log; }
+
+robot::TuningLog* robot::Chassis::getTuningLog() const { return tuningLog; }
+
+void robot::Chassis::recordTuning(float lateralError, float lateralOutput, float angularError, float angularOutput) {
+    TuningLog* log = tuningLog.load(std::memory_order_relaxed);
+    if (log == nullptr) return;
+    const lemlib::Pose speed = robot::getSpeed();
+    log->push({lateralError, lateralOutput, angularError, angularOutput, std::hypot(speed.x, speed.y), speed.theta});
+}
+
+void robot::Chassis::setLateralGains(PIDGains gains) { lateralPID.setGains(gains); }
+
+void robot::Chassis::setAngularGains(PIDGains gains) { angularPID.setGains(gains); }
+
+robot::PIDGains robot::Chassis::getLateralGains() const { return lateralPID.getGains(); }
+
+robot::PIDGains robot::Chassis::getAngularGains() const { return angularPID.getGains(); }
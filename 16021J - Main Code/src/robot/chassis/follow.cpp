@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include "pros/rtos.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "robot/chassis.hpp"
+
+// how many points ahead of the last closest point are searched every tick
+constexpr size_t SEARCH_WINDOW = 20;
+
+void robot::Chassis::follow(const asset& path, int timeout, FollowParams params, bool async) {
+    // the parsed path is shared with the motion task so it outlives this call
+    std::shared_ptr<const Path> parsed = std::make_shared<const Path>(path);
+    if (!async) {
+        follow(*parsed, timeout, params, false);
+        return;
+    }
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    pros::Task task([this, parsed, timeout, params]() { follow(*parsed, timeout, params, false); });
+    this->endMotion();
+    pros::delay(10); // delay to give the task time to start
+}
+
+void robot::Chassis::follow(const Path& path, int timeout, FollowParams params, bool async) {
+    follow(path, timeout, params, {}, async);
+}
+
+void robot::Chassis::follow(const Path& path, int timeout, FollowParams params, Markers markers, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, &path, timeout, params, markers]() { follow(path, timeout, params, markers, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+    track(path, timeout, params, markers);
+}
+
+void robot::Chassis::track(const Path& path, int timeout, FollowParams params, Markers& markers) {
+    // a path needs at least 2 points to be followed
+    if (path.size() < 2) {
+        this->endMotion();
+        return;
+    }
+
+    setActivePath(&path);
+    predictedEnd = pros::millis() + path.duration(maxVelocity()) * 1000;
+    lemlib::Pose pose = this->getPose(true, true);
+    size_t closest = 0;
+    float progress = 0;
+    float speed = 0;
+    bool exitedEarly = false;
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+
+    // loop until the path is done, the timer runs out, or the motion is cancelled
+    while (!timer.isDone() && this->motionRunning) {
+        // update the position and measured speed of the robot
+        const lemlib::Pose lastPose = pose;
+        pose = this->getPose(true, true);
+        speed = lemlib::ema(pose.distance(lastPose) / 0.01, speed, 0.5);
+        if (!params.forwards) pose.theta -= M_PI;
+
+        // find how far along the path the robot is by projecting it onto the closest segment
+        closest = path.closestIndex(pose, closest, SEARCH_WINDOW);
+        const size_t segment = closest + 1 < path.size() ? closest : closest - 1;
+        const PathPoint& a = path[segment];
+        const PathPoint& b = path[segment + 1];
+        const float segmentLength = b.distance - a.distance;
+        float t = 0;
+        if (segmentLength > 1e-6)
+            t = ((pose.x - a.x) * (b.x - a.x) + (pose.y - a.y) * (b.y - a.y)) / (segmentLength * segmentLength);
+        // progress never goes backwards, so waitUntil can't get stuck if the robot is pushed
+        progress = std::max(progress, a.distance + std::clamp(t, 0.0f, 1.0f) * segmentLength);
+        distTraveled = progress;
+
+        // exit at the end of the path, or early if requested
+        const float remaining = path.length() - progress;
+        setProgress(std::max(remaining, 0.0f), path.duration(maxVelocity(), progress, segment));
+        updateMarkers(markers, {progress, std::max(remaining, 0.0f), getMotionETA(), pose});
+        if (path[closest].speed == 0 || remaining <= 0) break;
+        if (params.earlyExitRange > 0 && remaining < params.earlyExitRange) {
+            exitedEarly = true;
+            break;
+        }
+
+        // grow the lookahead with speed, and shrink it if there is a sharp turn coming up
+        float lookahead = params.minLookahead + params.lookaheadSpeedGain * speed;
+        const float pathCurvature = path.maxCurvature(progress, progress + lookahead, segment);
+        lookahead /= 1 + params.lookaheadCurvatureGain * pathCurvature;
+        lookahead = std::clamp(lookahead, params.minLookahead, params.maxLookahead);
+        const lemlib::Pose lookaheadPose = path.sample(progress + lookahead, segment);
+
+        // calculate the curvature of the arc to the lookahead point
+        const float curvature = lemlib::getCurvature(pose, lookaheadPose);
+        const float targetVel = path.sample(progress, segment).theta;
+
+        // calculate target left and right velocities
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // ratio the speeds to respect the max speed
+        const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+
+        // move the drivetrain
+        if (params.forwards) {
+            drivetrain.leftMotors->move(targetLeftVel);
+            drivetrain.rightMotors->move(targetRightVel);
+        } else {
+            drivetrain.leftMotors->move(-targetRightVel);
+            drivetrain.rightMotors->move(-targetLeftVel);
+        }
+
+        pros::delay(10);
+    }
+
+    // stop the robot, unless the next motion is supposed to take over while moving
+    if (!exitedEarly) {
+        drivetrain.leftMotors->move(0);
+        drivetrain.rightMotors->move(0);
+    }
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    predictedEnd = 0;
+    clearProgress();
+    setActivePath(nullptr);
+    this->endMotion();
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include "pros/rtos.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "robot/chassis.hpp"
+
+void robot::Chassis::moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params, bool async) {
+    moveToPoint(x, y, timeout, params, {}, async);
+}
+
+// ported from lemlib::Chassis::moveToPoint (LemLib v0.5), with progress reporting and markers
+void robot::Chassis::moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params, Markers markers,
+                                 bool async) {
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, x, y, timeout, params, markers]() {
+            moveToPoint(x, y, timeout, params, markers, false);
+        });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // reset PIDs and exit conditions
+    lateralPID.reset();
+    angularPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+
+    // initialize vars used between iterations
+    lemlib::Pose lastPose = getPose(true, true);
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+    bool close = false;
+    bool chained = false;
+    float prevLateralOut = 0; // previous lateral power
+    float prevAngularOut = 0; // previous angular power
+    std::optional<bool> prevSide = std::nullopt;
+
+    // calculate target pose in standard form
+    lemlib::Pose target(x, y);
+    target.theta = lastPose.angle(target);
+    setProgress(lastPose.distance(target));
+
+    // main loop
+    while (!timer.isDone() && ((!lateralSmallExit.getExit() && !lateralLargeExit.getExit()) || !close) &&
+           this->motionRunning) {
+        // update position
+        const lemlib::Pose pose = getPose(true, true);
+
+        // update distance traveled
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // calculate distance to the target point
+        const float distTarget = pose.distance(target);
+        setProgress(distTarget);
+        updateMarkers(markers, {distTraveled, distTarget, getMotionETA(), pose});
+
+        // check if the robot is close enough to the target to start settling
+        if (distTarget < 7.5 && close == false) {
+            close = true;
+            params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+        }
+
+        // motion chaining
+        const bool side = (pose.y - target.y) * -std::sin(target.theta) <=
+                          (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        if (prevSide == std::nullopt) prevSide = side;
+        const bool sameSide = side == prevSide;
+        // exit if close
+        if (!sameSide && params.minSpeed != 0) {
+            chained = true;
+            break;
+        }
+        prevSide = side;
+
+        // calculate error
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError = lemlib::angleError(adjustedRobotTheta, pose.angle(target));
+        float lateralError = distTarget * std::cos(lemlib::angleError(pose.theta, pose.angle(target)));
+
+        // update exit conditions
+        lateralSmallExit.update(lateralError);
+        lateralLargeExit.update(lateralError);
+
+        // get output from PIDs
+        float lateralOut = lateralPID.update(lateralError);
+        float angularOut = angularPID.update(lemlib::radToDeg(angularError));
+        if (close) angularOut = 0;
+
+        // apply restrictions on angular speed
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+        angularOut = lemlib::slew(angularOut, prevAngularOut, angularSettings.slew);
+
+        // apply restrictions on lateral speed
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+
+        // constrain lateral output by max accel
+        if (!close) lateralOut = lemlib::slew(lateralOut, prevLateralOut, lateralSettings.slew);
+
+        // prevent moving in the wrong direction
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+
+        // constrain lateral output by the minimum speed
+        if (params.forwards && lateralOut < std::fabs(params.minSpeed) && lateralOut > 0)
+            lateralOut = std::fabs(params.minSpeed);
+        if (!params.forwards && -lateralOut < std::fabs(params.minSpeed) && lateralOut < 0)
+            lateralOut = -std::fabs(params.minSpeed);
+
+        // update previous output
+        prevLateralOut = lateralOut;
+        prevAngularOut = angularOut;
+        recordTuning(lateralError, lateralOut, lemlib::radToDeg(angularError), angularOut);
+
+        // ratio the speeds to respect the max speed
+        float leftPower = lateralOut + angularOut;
+        float rightPower = lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+
+        // move the drivetrain
+        drivetrain.leftMotors->move(leftPower);
+        drivetrain.rightMotors->move(rightPower);
+
+        // delay to save resources
+        pros::delay(10);
+    }
+
+    // stop the drivetrain, unless the next motion is chained onto this one
+    if (!chained) {
+        drivetrain.leftMotors->move(0);
+        drivetrain.rightMotors->move(0);
+    }
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    clearProgress();
+    this->endMotion();
+}
@@ -0,0 +1,83 @@
+#include <cmath>
+#include <optional>
+#include "pros/rtos.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "robot/chassis.hpp"
+
+// ported from lemlib::Chassis::turnToHeading (LemLib v0.5), using the tunable angular controller
+void robot::Chassis::turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, theta, timeout, params]() { turnToHeading(theta, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // reset PIDs and exit conditions
+    angularPID.reset();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+
+    // initialize vars used between iterations
+    const float startTheta = getPose().theta;
+    float prevMotorPower = 0;
+    bool settling = false;
+    std::optional<float> prevRawDeltaTheta = std::nullopt;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+
+    // main loop
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && this->motionRunning) {
+        // update position
+        const lemlib::Pose pose = getPose();
+        distTraveled = std::fabs(lemlib::angleError(pose.theta, startTheta, false));
+
+        // once the robot passes the target, turn whichever way is shortest, to settle
+        const float rawDeltaTheta = lemlib::angleError(theta, pose.theta, false);
+        if (prevRawDeltaTheta == std::nullopt) prevRawDeltaTheta = rawDeltaTheta;
+        if (lemlib::sgn(rawDeltaTheta) != lemlib::sgn(*prevRawDeltaTheta)) settling = true;
+        prevRawDeltaTheta = rawDeltaTheta;
+
+        // calculate error
+        const float deltaTheta = settling ? lemlib::angleError(theta, pose.theta, false)
+                                          : lemlib::angleError(theta, pose.theta, false, params.direction);
+        if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+        // motion chaining
+        if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+        if (params.minSpeed != 0 && lemlib::sgn(deltaTheta) != lemlib::sgn(*prevDeltaTheta)) break;
+
+        // get output from PID and update exit conditions
+        float motorPower = angularPID.update(deltaTheta);
+        angularLargeExit.update(deltaTheta);
+        angularSmallExit.update(deltaTheta);
+
+        // apply restrictions on speed
+        motorPower = std::fmax(std::fmin(motorPower, params.maxSpeed), -params.maxSpeed);
+        if (std::fabs(deltaTheta) > 20) motorPower = lemlib::slew(motorPower, prevMotorPower, angularSettings.slew);
+        if (motorPower < 0 && motorPower > -params.minSpeed) motorPower = -params.minSpeed;
+        else if (motorPower > 0 && motorPower < params.minSpeed) motorPower = params.minSpeed;
+        prevMotorPower = motorPower;
+        recordTuning(0, 0, deltaTheta, motorPower);
+
+        // move the drivetrain
+        drivetrain.leftMotors->move(motorPower);
+        drivetrain.rightMotors->move(-motorPower);
+
+        // delay to save resources
+        pros::delay(10);
+    }
+
+    // stop the drivetrain
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
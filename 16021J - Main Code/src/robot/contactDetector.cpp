@@ -0,0 +1,68 @@
+#include <cmath>
+#include <cstdlib>
+#include "pros/error.h"
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "robot/contactDetector.hpp"
+#include "robot/odom.hpp"
+
+namespace robot {
+
+ContactDetector::ContactDetector(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors,
+                                 ContactSettings settings)
+    : leftMotors(leftMotors),
+      rightMotors(rightMotors),
+      settings(settings) {}
+
+bool ContactDetector::getExit() { return done; }
+
+bool ContactDetector::update() {
+    if (done) return true;
+    const int now = pros::millis();
+    if (startTime == -1) startTime = now;
+
+    // average current draw and speed of every drive motor
+    float current = 0;
+    float motorSpeed = 0;
+    int count = 0;
+    for (pros::MotorGroup* motors : {leftMotors, rightMotors}) {
+        for (int i = 0; i < motors->size(); i++) {
+            const std::int32_t draw = motors->get_current_draw(i);
+            const double velocity = motors->get_actual_velocity(i);
+            // a motor that is unplugged reports errors, which would look like a huge current draw
+            if (draw == PROS_ERR || velocity == PROS_ERR_F) continue;
+            current += std::abs(draw);
+            motorSpeed += std::fabs(velocity);
+            count++;
+        }
+    }
+    if (count == 0) return false;
+    current /= count;
+    motorSpeed /= count;
+    const lemlib::Pose speed = robot::getSpeed();
+    const float odomSpeed = std::hypot(speed.x, speed.y);
+    peakMotorSpeed = std::fmax(peakMotorSpeed, motorSpeed);
+    peakOdomSpeed = std::fmax(peakOdomSpeed, odomSpeed);
+
+    // motors draw a lot of current while accelerating, so give them time to get up to speed
+    if (now - startTime < settings.ignoreTime) return false;
+
+    const bool slowed =
+        motorSpeed < peakMotorSpeed * settings.speedRatio || odomSpeed < peakOdomSpeed * settings.speedRatio;
+    if (current < settings.current || !slowed) {
+        contactTime = -1;
+        return false;
+    }
+    if (contactTime == -1) contactTime = now;
+    if (now - contactTime >= settings.confirmTime) done = true;
+    return done;
+}
+
+void ContactDetector::reset() {
+    startTime = -1;
+    contactTime = -1;
+    peakMotorSpeed = 0;
+    peakOdomSpeed = 0;
+    done = false;
+}
+} // namespace robot
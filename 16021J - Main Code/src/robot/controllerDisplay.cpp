@@ -0,0 +1,99 @@
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "pros/error.h"
+#include "robot/controllerDisplay.hpp"
+
+namespace robot {
+
+ControllerDisplay::ControllerDisplay(pros::Controller& controller)
+    : controller(controller) {
+    for (Line& line : wanted) copyPadded(line, "");
+}
+
+void ControllerDisplay::start() {
+    if (task != nullptr) return;
+    task = new pros::Task {[this] {
+                               std::uint32_t now = pros::millis();
+                               while (true) {
+                                   update();
+                                   pros::Task::delay_until(&now, UPDATE_PERIOD);
+                               }
+                           },
+                           TASK_PRIORITY_DEFAULT - 2};
+}
+
+void ControllerDisplay::setLine(std::uint8_t line, const char* fmt, ...) {
+    if (line >= LINES) return;
+    char text[LINE_WIDTH + 1];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    std::lock_guard<pros::Mutex> lock(mutex);
+    copyPadded(wanted[line], text);
+}
+
+void ControllerDisplay::alert(const char* text, int duration, const char* rumble) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    copyPadded(alertText, text);
+    alertUntil = pros::millis() + duration;
+    if (rumble == nullptr) return;
+    std::strncpy(rumblePattern.data(), rumble, rumblePattern.size() - 1);
+    rumblePattern.back() = '\0';
+}
+
+void ControllerDisplay::copyPadded(Line& line, const char* text) {
+    // pad with spaces, so text that got shorter overwrites the end of the old text
+    size_t i = 0;
+    for (; i < LINE_WIDTH && text[i] != '\0'; i++) line[i] = text[i];
+    for (; i < LINE_WIDTH; i++) line[i] = ' ';
+    line[LINE_WIDTH] = '\0';
+}
+
+void ControllerDisplay::update() {
+    // the screen of a controller that just connected is unknown, so send everything again
+    const bool nowConnected = controller.is_connected();
+    if (nowConnected && !connected) {
+        for (Line& line : sent) line.fill('\0');
+    }
+    connected = nowConnected;
+    if (!connected) return;
+
+    std::array<Line, LINES> shown;
+    std::array<char, 9> rumble;
+    {
+        std::lock_guard<pros::Mutex> lock(mutex);
+        shown = wanted;
+        if (static_cast<std::int32_t>(alertUntil - pros::millis()) > 0) shown[LINES - 1] = alertText;
+        rumble = rumblePattern;
+    }
+
+    // the controller takes one update at a time, so a rumble uses up this update
+    if (rumble[0] != '\0') {
+        if (controller.rumble(rumble.data()) == PROS_ERR) return;
+        std::lock_guard<pros::Mutex> lock(mutex);
+        if (rumblePattern == rumble) rumblePattern[0] = '\0';
+        return;
+    }
+
+    // send the changed part of the next line that changed, taking turns so one busy line can't starve the rest
+    for (size_t i = 0; i < LINES; i++) {
+        const size_t line = (nextLine + i) % LINES;
+        size_t first = 0;
+        while (first < LINE_WIDTH && shown[line][first] == sent[line][first]) first++;
+        if (first == LINE_WIDTH) continue;
+        size_t last = LINE_WIDTH - 1;
+        while (shown[line][last] == sent[line][last]) last--;
+
+        char text[LINE_WIDTH + 1];
+        std::memcpy(text, shown[line].data() + first, last - first + 1);
+        text[last - first + 1] = '\0';
+        if (controller.set_text(line, first, text) != PROS_ERR)
+            std::memcpy(sent[line].data() + first, text, last - first + 1);
+        nextLine = line + 1;
+        return;
+    }
+}
+} // namespace robot
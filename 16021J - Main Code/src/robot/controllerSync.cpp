@@ -0,0 +1,86 @@
+#include <algorithm>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "robot/controllerSync.hpp"
+
+namespace robot {
+
+// changes further apart than this are the driver stopping and starting, not consecutive packets
+constexpr std::uint64_t MAX_PACKET_INTERVAL = 50000;
+
+ControllerSync::ControllerSync(pros::Controller& controller, int period, int reportPeriod)
+    : controller(controller),
+      period(period),
+      reportPeriod(reportPeriod) {}
+
+bool ControllerSync::wait() {
+    const std::uint32_t now = pros::millis();
+    // the first tick, or the first since the loop stopped, like between driver control periods. Start from now
+    // instead of running every tick that was missed
+    const bool resumed = !running || now - wakeTime > static_cast<std::uint32_t>(2 * period);
+    if (resumed) {
+        if (!running) lastReport = now;
+        running = true;
+        wakeTime = now;
+        lastChangeTime = 0;
+    } else {
+        pros::Task::delay_until(&wakeTime, period);
+        if (pros::millis() > wakeTime + 1) overruns++;
+    }
+    previousTickTime = tickTime;
+    tickTime = pros::micros();
+
+    const Sticks current {controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X),
+                          controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y),
+                          controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X),
+                          controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y)};
+    const bool changed = current.leftX != sticks.leftX || current.leftY != sticks.leftY ||
+                         current.rightX != sticks.rightX || current.rightY != sticks.rightY;
+    sticks = current;
+    // when the change arrived isn't known after a pause, so it's applied but not measured
+    measure = changed && !resumed;
+    if (changed) {
+        if (lastChangeTime != 0 && tickTime - lastChangeTime <= MAX_PACKET_INTERVAL) {
+            intervals++;
+            totalInterval += tickTime - lastChangeTime;
+        }
+        lastChangeTime = tickTime;
+    }
+    if (wakeTime - lastReport >= static_cast<std::uint32_t>(reportPeriod)) report(wakeTime);
+    return changed;
+}
+
+Sticks ControllerSync::getSticks() const { return sticks; }
+
+void ControllerSync::applied() {
+    if (!measure) return;
+    measure = false;
+    const std::uint64_t now = pros::micros();
+    // the change arrived some time after the previous tick read the sticks, and before this one did
+    changes++;
+    totalLatency += now - (previousTickTime + tickTime) / 2;
+    maxLatency = std::max(maxLatency, now - previousTickTime);
+}
+
+void ControllerSync::report(std::uint32_t now) {
+    DriverLatency current;
+    current.changes = changes;
+    current.meanLatency = changes == 0 ? 0 : totalLatency / 1000.0f / changes;
+    current.maxLatency = maxLatency / 1000.0f;
+    current.packetInterval = intervals == 0 ? 0 : totalInterval / 1000.0f / intervals;
+    current.overruns = overruns;
+    latency.store(current);
+    lemlib::telemetrySink()->info("driver,{},{:.2f},{:.2f},{:.2f},{}", current.changes, current.meanLatency,
+                                  current.maxLatency, current.packetInterval, current.overruns);
+
+    changes = 0;
+    totalLatency = 0;
+    maxLatency = 0;
+    intervals = 0;
+    totalInterval = 0;
+    overruns = 0;
+    lastReport = now;
+}
+
+DriverLatency ControllerSync::getLatency() const { return latency.load(); }
+} // namespace robot
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "robot/odom.hpp"
+#include "robot/dashboard.hpp"
+
+namespace robot {
+
+constexpr lv_coord_t MARGIN = 20;
+constexpr lv_coord_t ROW_HEIGHT = 22;
+
+Dashboard::Dashboard(Chassis& chassis, DashboardSettings settings)
+    : chassis(chassis),
+      settings(settings),
+      field(chassis, settings.field) {}
+
+bool Dashboard::addMotors(const char* name, pros::MotorGroup* motors) {
+    if (motorCount >= MAX_MOTOR_GROUPS || screen != nullptr) return false;
+    motorRows[motorCount].name = name;
+    motorRows[motorCount].motors = motors;
+    motorCount++;
+    return true;
+}
+
+void Dashboard::start() {
+    if (screen != nullptr) return;
+    screen = lv_obj_create(nullptr);
+    lv_obj_set_style_bg_color(screen, lv_color_black(), 0);
+    lv_obj_set_style_text_color(screen, lv_color_white(), 0);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+
+    field.create(screen, MARGIN, MARGIN);
+
+    const lv_coord_t column = 2 * MARGIN + settings.field.size;
+    poseLabel = createLabel(column, MARGIN);
+    statusLabel = createLabel(column, MARGIN + 3 * ROW_HEIGHT);
+    batteryLabel = createLabel(column, MARGIN + 4 * ROW_HEIGHT);
+    for (size_t i = 0; i < motorCount; i++) {
+        motorRows[i].label = createLabel(column, MARGIN + (5 + i) * ROW_HEIGHT);
+    }
+
+    lv_scr_load(screen);
+    // LVGL runs timers in the same task that draws the screen, so the widgets can be changed without a lock
+    timer = lv_timer_create([](lv_timer_t* timer) { static_cast<Dashboard*>(timer->user_data)->update(); },
+                            settings.period, this);
+    // fill in the labels on the next LVGL tick instead of calling update() here, since this isn't the LVGL task
+    lv_timer_ready(timer);
+}
+
+std::uint32_t Dashboard::getUpdateTime() const { return updateTime; }
+
+int Dashboard::getOverBudgetCount() const { return overBudgetCount; }
+
+lv_obj_t* Dashboard::getScreen() const { return screen; }
+
+lv_obj_t* Dashboard::createLabel(lv_coord_t x, lv_coord_t y) {
+    lv_obj_t* label = lv_label_create(screen);
+    lv_obj_set_pos(label, x, y);
+    lv_label_set_text_static(label, "");
+    return label;
+}
+
+void Dashboard::update() {
+    const std::uint64_t start = pros::micros();
+    char text[64];
+
+    // round to what is shown, so noise in the last digit doesn't redraw anything
+    const lemlib::Pose pose = getPose();
+    const int newX = std::lround(pose.x * 10);
+    const int newY = std::lround(pose.y * 10);
+    const int newTheta = ((std::lround(pose.theta) % 360) + 360) % 360;
+    if (newX != x || newY != y || newTheta != theta) {
+        x = newX;
+        y = newY;
+        theta = newTheta;
+        std::snprintf(text, sizeof(text), "X: %.1f\nY: %.1f\nTheta: %d", x / 10.0, y / 10.0, theta);
+        lv_label_set_text(poseLabel, text);
+    }
+
+    field.update(pose);
+
+    const int newCalibrationTime = chassis.isCalibrated() ? chassis.getCalibrationTime() : 0;
+    if (newCalibrationTime != calibrationTime) {
+        calibrationTime = newCalibrationTime;
+        if (calibrationTime == 0) lv_label_set_text_static(statusLabel, "Calibrating...");
+        else lv_label_set_text_fmt(statusLabel, "Calibrated in %d ms", calibrationTime);
+    }
+
+    const int newBattery = std::lround(pros::battery::get_capacity());
+    if (newBattery != battery) {
+        battery = newBattery;
+        lv_label_set_text_fmt(batteryLabel, "Battery: %d%%", battery);
+    }
+
+    for (size_t i = 0; i < motorCount; i++) {
+        MotorRow& row = motorRows[i];
+        double hottest = 0;
+        for (int j = 0; j < row.motors->size(); j++) {
+            const double temperature = row.motors->get_temperature(j);
+            if (std::isfinite(temperature)) hottest = std::max(hottest, temperature);
+        }
+        const int temperature = std::lround(hottest);
+        if (temperature == row.temperature) continue;
+        row.temperature = temperature;
+        lv_label_set_text_fmt(row.label, "%s: %d C", row.name, temperature);
+    }
+
+    updateTime = pros::micros() - start;
+    if (updateTime > static_cast<std::uint32_t>(settings.budget)) overBudgetCount++;
+}
+} // namespace robot
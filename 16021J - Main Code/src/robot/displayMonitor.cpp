@@ -0,0 +1,74 @@
+#include <algorithm>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "robot/displayMonitor.hpp"
+
+namespace robot {
+
+// LVGL's monitor callback has no user data, so the running monitor is kept here
+static DisplayMonitor* instance = nullptr;
+
+DisplayMonitor::DisplayMonitor(DisplayBudget budget)
+    : budget(budget) {}
+
+bool DisplayMonitor::start() {
+    if (instance != nullptr) return instance == this;
+    lv_disp_t* display = lv_disp_get_default();
+    if (display == nullptr) return false;
+    instance = this;
+    lastReport = pros::millis();
+    // keep calling the callback the display driver had, if any
+    previousMonitor = display->driver->monitor_cb;
+    display->driver->monitor_cb = [](lv_disp_drv_t* driver, std::uint32_t time, std::uint32_t pixels) {
+        instance->onRefresh(time, pixels);
+        if (instance->previousMonitor != nullptr) instance->previousMonitor(driver, time, pixels);
+    };
+    // the heap can only be read from the LVGL task, so the report runs as an LVGL timer too
+    timer = lv_timer_create([](lv_timer_t* timer) { static_cast<DisplayMonitor*>(timer->user_data)->report(); },
+                            budget.reportPeriod, this);
+    return true;
+}
+
+DisplayStats DisplayMonitor::getStats() const { return stats.load(); }
+
+void DisplayMonitor::onRefresh(std::uint32_t time, std::uint32_t pixels) {
+    refreshes++;
+    totalTime += time;
+    totalPixels += pixels;
+    maxTime = std::max(maxTime, time);
+}
+
+void DisplayMonitor::report() {
+    const std::uint32_t now = pros::millis();
+    const std::uint32_t elapsed = std::max<std::uint32_t>(now - lastReport, 1);
+    lv_mem_monitor_t memory;
+    lv_mem_monitor(&memory);
+
+    DisplayStats current;
+    current.refreshes = refreshes;
+    current.refreshTime = refreshes > 0 ? float(totalTime) / refreshes : 0;
+    current.maxRefreshTime = maxTime;
+    current.pixels = refreshes > 0 ? totalPixels / refreshes : 0;
+    current.cpuShare = float(totalTime) / elapsed;
+    current.memoryUsed = memory.total_size - memory.free_size;
+    current.memoryPeak = memory.max_used;
+    current.memoryTotal = memory.total_size;
+    current.fragmentation = memory.frag_pct;
+    const bool overBudget = maxTime > budget.refreshTime || current.cpuShare > budget.cpuShare ||
+                            current.memoryUsed > budget.memoryUsed * memory.total_size;
+    if (overBudget) overBudgetCount++;
+    current.overBudgetCount = overBudgetCount;
+    stats.store(current);
+
+    // refreshes, average ms, max ms, average pixels, cpu share, heap used, heap peak, heap size, over budget
+    lemlib::telemetrySink()->info("display,{},{:.2f},{},{},{:.3f},{},{},{},{}", current.refreshes,
+                                  current.refreshTime, current.maxRefreshTime, current.pixels, current.cpuShare,
+                                  current.memoryUsed, current.memoryPeak, current.memoryTotal, overBudget);
+
+    refreshes = 0;
+    totalTime = 0;
+    totalPixels = 0;
+    maxTime = 0;
+    lastReport = now;
+}
+} // namespace robot
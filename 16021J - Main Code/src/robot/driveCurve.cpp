@@ -0,0 +1,17 @@
+#include <cmath>
+#include "robot/driveCurve.hpp"
+
+namespace robot {
+
+TableDriveCurve::TableDriveCurve(float deadband, float minOutput, float curve) {
+    // the same calculation as lemlib::ExpoDriveCurve::curve, in the same float precision
+    lemlib::ExpoDriveCurve expo(deadband, minOutput, curve);
+    for (int input = -127; input <= 127; input++) table[input + 127] = expo.curve(input);
+}
+
+float TableDriveCurve::curve(float input) {
+    if (!(input > -127)) return table.front(); // also catches NaN
+    if (input >= 127) return table.back();
+    return table[static_cast<int>(std::lround(input)) + 127];
+}
+} // namespace robot
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include "robot/fieldMap.hpp"
+
+namespace {
+
+// the table covers a square slightly larger than the field, with points 8 inches apart
+constexpr float GRID_HALF = 72;
+constexpr int GRID_SIZE = 19;
+constexpr float GRID_STEP = 2 * GRID_HALF / (GRID_SIZE - 1);
+// 5 degrees between directions
+constexpr int ANGLE_BINS = 72;
+constexpr float ANGLE_STEP = 2 * M_PI / ANGLE_BINS;
+// distances are stored in 1/16ths of an inch
+constexpr float DISTANCE_SCALE = 16;
+
+using FieldMap = std::array<std::uint16_t, ANGLE_BINS * GRID_SIZE * GRID_SIZE>;
+
+// std::sin isn't constexpr, so use its taylor series
+constexpr double constexprSin(double x) {
+    while (x > M_PI) x -= 2 * M_PI;
+    while (x < -M_PI) x += 2 * M_PI;
+    double term = x;
+    double sum = x;
+    for (int i = 1; i < 12; i++) {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double castRay(double x, double y, double theta) {
+    const double dirX = constexprSin(theta);
+    const double dirY = constexprSin(theta + M_PI / 2);
+    double distance = 2 * GRID_HALF * M_SQRT2;
+    if (dirX > 1e-6) distance = std::min(distance, (robot::FIELD_HALF_WIDTH - x) / dirX);
+    if (dirX < -1e-6) distance = std::min(distance, (-robot::FIELD_HALF_WIDTH - x) / dirX);
+    if (dirY > 1e-6) distance = std::min(distance, (robot::FIELD_HALF_WIDTH - y) / dirY);
+    if (dirY < -1e-6) distance = std::min(distance, (-robot::FIELD_HALF_WIDTH - y) / dirY);
+    return std::max(distance, 0.0);
+}
+
+constexpr FieldMap buildFieldMap() {
+    FieldMap map {};
+    for (int a = 0; a < ANGLE_BINS; a++) {
+        for (int i = 0; i < GRID_SIZE; i++) {
+            for (int j = 0; j < GRID_SIZE; j++) {
+                const double distance = castRay(i * GRID_STEP - GRID_HALF, j * GRID_STEP - GRID_HALF, a * ANGLE_STEP);
+                map[(a * GRID_SIZE + i) * GRID_SIZE + j] = static_cast<std::uint16_t>(distance * DISTANCE_SCALE + 0.5);
+            }
+        }
+    }
+    return map;
+}
+
+constexpr FieldMap FIELD_MAP = buildFieldMap();
+
+// bilinear interpolation between the 4 grid points around a position
+float interpolate(int angle, int i, int j, float fx, float fy) {
+    const std::uint16_t* row = &FIELD_MAP[(angle * GRID_SIZE + i) * GRID_SIZE + j];
+    const float low = row[0] + (row[1] - row[0]) * fy;
+    const float high = row[GRID_SIZE] + (row[GRID_SIZE + 1] - row[GRID_SIZE]) * fy;
+    return low + (high - low) * fx;
+}
+} // namespace
+
+float robot::fieldDistance(float x, float y, float theta) {
+    const float gx = std::clamp((x + GRID_HALF) / GRID_STEP, 0.0f, GRID_SIZE - 1.001f);
+    const float gy = std::clamp((y + GRID_HALF) / GRID_STEP, 0.0f, GRID_SIZE - 1.001f);
+    float ga = theta / ANGLE_STEP;
+    ga -= std::floor(ga / ANGLE_BINS) * ANGLE_BINS;
+    const int i = gx;
+    const int j = gy;
+    const int a = static_cast<int>(ga) % ANGLE_BINS;
+    const float fx = gx - i;
+    const float fy = gy - j;
+    const float fa = ga - static_cast<int>(ga);
+    const float current = interpolate(a, i, j, fx, fy);
+    const float next = interpolate((a + 1) % ANGLE_BINS, i, j, fx, fy);
+    return (current + (next - current) * fa) / DISTANCE_SCALE;
+}
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "lemlib/util.hpp"
+#include "robot/fieldView.hpp"
+
+namespace robot {
+
+// the map covers the whole field, including the walls
+constexpr float FIELD_WIDTH = 144;
+constexpr float TILE_WIDTH = 24;
+// moving further than this between two updates means the pose was set, so the trail isn't connected
+constexpr float MAX_JUMP = 24;
+
+FieldView::FieldView(Chassis& chassis, FieldViewSettings settings)
+    : chassis(chassis),
+      settings(settings),
+      scale(settings.size / FIELD_WIDTH) {}
+
+void FieldView::create(lv_obj_t* parent, lv_coord_t x, lv_coord_t y) {
+    if (canvas != nullptr) return;
+    // both buffers are allocated once, so drawing never allocates
+    field.resize(settings.size * settings.size);
+    pixels.resize(settings.size * settings.size);
+    trail.reserve(settings.trailLength);
+    drawField();
+
+    canvas = lv_canvas_create(parent);
+    lv_obj_set_pos(canvas, x, y);
+    lv_obj_clear_flag(canvas, LV_OBJ_FLAG_SCROLLABLE);
+    lv_canvas_set_buffer(canvas, pixels.data(), settings.size, settings.size, LV_IMG_CF_TRUE_COLOR);
+
+    footprint = lv_line_create(canvas);
+    lv_obj_set_style_line_width(footprint, 2, 0);
+    lv_obj_set_style_line_color(footprint, lv_palette_main(LV_PALETTE_RED), 0);
+    redraw();
+}
+
+void FieldView::update(lemlib::Pose pose) {
+    if (canvas == nullptr) return;
+    // the path only has to be copied and drawn when a motion starts or ends
+    if (chassis.getActivePathVersion() != pathVersion) {
+        pathVersion = chassis.copyActivePath(path);
+        redraw();
+    }
+
+    if (trail.empty()) {
+        trail.push_back({pose.x, pose.y, false});
+    } else {
+        const TrailPoint& last = trail.back();
+        const float distance = std::hypot(pose.x - last.x, pose.y - last.y);
+        if (distance >= settings.trailSpacing) {
+            if (trail.size() >= settings.trailLength) {
+                trail.erase(trail.begin(), trail.begin() + trail.size() / 2);
+                trail.front().connected = false;
+                redraw();
+            }
+            trail.push_back({pose.x, pose.y, distance < MAX_JUMP});
+            drawTrailSegment(trail.size() - 1, true);
+        }
+    }
+    moveFootprint(pose);
+}
+
+void FieldView::clearTrail() {
+    trail.clear();
+    if (canvas != nullptr) redraw();
+}
+
+lv_point_t FieldView::toPixel(float x, float y) const {
+    return {static_cast<lv_coord_t>(std::lround((x + FIELD_WIDTH / 2) * scale)),
+            static_cast<lv_coord_t>(std::lround((FIELD_WIDTH / 2 - y) * scale))};
+}
+
+void FieldView::redraw() {
+    std::copy(field.begin(), field.end(), pixels.begin());
+    drawPath();
+    for (size_t i = 1; i < trail.size(); i++) drawTrailSegment(i, false);
+    lv_obj_invalidate(canvas);
+}
+
+void FieldView::drawField() {
+    const lv_coord_t end = settings.size - 1;
+    fillRect(0, 0, end, end, lv_color_hex(0x505050));
+    // tile seams
+    for (float position = -FIELD_WIDTH / 2 + TILE_WIDTH; position < FIELD_WIDTH / 2; position += TILE_WIDTH) {
+        const lv_coord_t seam = std::lround((position + FIELD_WIDTH / 2) * scale);
+        fillRect(seam, 0, seam, end, lv_color_hex(0x6a6a6a));
+        fillRect(0, seam, end, seam, lv_color_hex(0x6a6a6a));
+    }
+    // center line
+    const lv_point_t center = toPixel(0, 0);
+    fillRect(center.x, 0, center.x, end, lv_color_white());
+    // walls
+    fillRect(0, 0, end, 1, lv_color_black());
+    fillRect(0, end - 1, end, end, lv_color_black());
+    fillRect(0, 0, 1, end, lv_color_black());
+    fillRect(end - 1, 0, end, end, lv_color_black());
+    std::swap(field, pixels);
+}
+
+void FieldView::drawPath() {
+    for (size_t i = 1; i < path.size(); i++) {
+        drawLine(toPixel(path[i - 1].x, path[i - 1].y), toPixel(path[i].x, path[i].y),
+                 lv_palette_main(LV_PALETTE_CYAN), false);
+    }
+}
+
+void FieldView::drawTrailSegment(size_t index, bool invalidate) {
+    if (!trail[index].connected) return;
+    drawLine(toPixel(trail[index - 1].x, trail[index - 1].y), toPixel(trail[index].x, trail[index].y),
+             lv_palette_main(LV_PALETTE_YELLOW), invalidate);
+}
+
+void FieldView::drawLine(lv_point_t a, lv_point_t b, lv_color_t color, bool invalidate) {
+    // Bresenham's line algorithm, straight into the canvas buffer
+    const int dx = std::abs(b.x - a.x);
+    const int dy = -std::abs(b.y - a.y);
+    const int stepX = a.x < b.x ? 1 : -1;
+    const int stepY = a.y < b.y ? 1 : -1;
+    int error = dx + dy;
+    lv_coord_t x = a.x;
+    lv_coord_t y = a.y;
+    while (true) {
+        if (x >= 0 && y >= 0 && x < settings.size && y < settings.size) pixels[y * settings.size + x] = color;
+        if (x == b.x && y == b.y) break;
+        if (2 * error >= dy) {
+            error += dy;
+            x += stepX;
+        }
+        if (2 * error <= dx) {
+            error += dx;
+            y += stepY;
+        }
+    }
+    if (!invalidate) return;
+    // only redraw the part of the screen around the new segment
+    lv_area_t area;
+    lv_obj_get_coords(canvas, &area);
+    const lv_coord_t left = area.x1;
+    const lv_coord_t top = area.y1;
+    area.x1 = left + std::min(a.x, b.x);
+    area.y1 = top + std::min(a.y, b.y);
+    area.x2 = left + std::max(a.x, b.x);
+    area.y2 = top + std::max(a.y, b.y);
+    lv_obj_invalidate_area(canvas, &area);
+}
+
+void FieldView::fillRect(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2, lv_color_t color) {
+    x1 = std::max<lv_coord_t>(x1, 0);
+    y1 = std::max<lv_coord_t>(y1, 0);
+    x2 = std::min<lv_coord_t>(x2, settings.size - 1);
+    y2 = std::min<lv_coord_t>(y2, settings.size - 1);
+    for (lv_coord_t y = y1; y <= y2; y++) {
+        std::fill(pixels.begin() + y * settings.size + x1, pixels.begin() + y * settings.size + x2 + 1, color);
+    }
+}
+
+void FieldView::moveFootprint(lemlib::Pose pose) {
+    // outline of the robot, with a line from the center to the front so the heading is visible
+    const float theta = lemlib::degToRad(pose.theta);
+    const float forwardX = std::sin(theta);
+    const float forwardY = std::cos(theta);
+    const float front = settings.robotLength / 2;
+    const float side = settings.robotWidth / 2;
+    const float corners[7][2] = {{0, 0}, {0, front}, {-side, front}, {-side, -front},
+                                 {side, -front}, {side, front}, {0, front}};
+    lv_point_t points[7];
+    lv_coord_t left = LV_COORD_MAX;
+    lv_coord_t top = LV_COORD_MAX;
+    for (int i = 0; i < 7; i++) {
+        const float right = corners[i][0];
+        const float forward = corners[i][1];
+        points[i] = toPixel(pose.x + right * forwardY + forward * forwardX,
+                            pose.y - right * forwardX + forward * forwardY);
+        left = std::min(left, points[i].x);
+        top = std::min(top, points[i].y);
+    }
+    // keep the line object as small as the robot, so moving it only redraws the area around the robot
+    for (lv_point_t& point : points) {
+        point.x -= left;
+        point.y -= top;
+    }
+    if (lv_obj_get_x(footprint) != left || lv_obj_get_y(footprint) != top) lv_obj_set_pos(footprint, left, top);
+    if (std::equal(points, points + 7, footprintPoints,
+                   [](lv_point_t a, lv_point_t b) { return a.x == b.x && a.y == b.y; }))
+        return;
+    std::copy(points, points + 7, footprintPoints);
+    lv_line_set_points(footprint, footprintPoints, 7);
+}
+} // namespace robot
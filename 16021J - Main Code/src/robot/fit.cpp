@@ -0,0 +1,43 @@
+#include <cmath>
+#include "robot/fit.hpp"
+
+robot::LineFit robot::fitLine(const float* x, const float* y, size_t n) {
+    if (n < 2) return {};
+    double meanX = 0;
+    double meanY = 0;
+    for (size_t i = 0; i < n; i++) {
+        meanX += x[i];
+        meanY += y[i];
+    }
+    meanX /= n;
+    meanY /= n;
+    // sums of squares around the means, more accurate than the textbook formula with floats
+    double xx = 0;
+    double xy = 0;
+    double yy = 0;
+    for (size_t i = 0; i < n; i++) {
+        xx += (x[i] - meanX) * (x[i] - meanX);
+        xy += (x[i] - meanX) * (y[i] - meanY);
+        yy += (y[i] - meanY) * (y[i] - meanY);
+    }
+    if (xx < 1e-12) return {};
+    const double slope = xy / xx;
+    const double rSquared = yy < 1e-12 ? 1 : xy * xy / (xx * yy);
+    return {float(slope), float(meanY - slope * meanX), float(rSquared)};
+}
+
+robot::TrackingWheelFit robot::fitTrackingWheel(const float* angles, const float* distances, size_t n,
+                                                float pushDistance, float pushMeasured) {
+    TrackingWheelFit fit;
+    if (n < 2) return fit;
+    const LineFit line = fitLine(angles, distances, n);
+    fit.valid = true;
+    fit.offset = -line.slope;
+    fit.rSquared = line.rSquared;
+    // the offset scales with the real wheel diameter
+    if (pushDistance > 0 && pushMeasured >= 1) {
+        fit.diameterScale = pushDistance / pushMeasured;
+        fit.offset *= fit.diameterScale;
+    }
+    return fit;
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include "pros/error.h"
+#include "robot/fusedImu.hpp"
+#include "robot/odom.hpp"
+
+namespace robot {
+
+// an IMU reports it's calibrating a little after it's reset, so don't check it before then
+constexpr std::uint32_t CALIBRATION_START_TIME = 100;
+constexpr size_t MAX_IMUS = 8;
+// a drive motor with more voltage than this is being driven, in millivolts
+constexpr std::int32_t MAX_STATIONARY_VOLTAGE = 500;
+
+FusedImu::FusedImu(std::initializer_list<std::uint8_t> ports, FusedImuSettings settings)
+    : pros::Imu(ports.size() > 0 ? *ports.begin() : 0),
+      settings(settings) {
+    sensors.reserve(ports.size());
+    for (std::uint8_t port : ports) sensors.push_back({pros::Imu(port)});
+}
+
+void FusedImu::setMotors(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    this->leftMotors = leftMotors;
+    this->rightMotors = rightMotors;
+}
+
+std::int32_t FusedImu::reset(bool blocking) const {
+    if (sensors.empty()) return PROS_ERR;
+    {
+        std::lock_guard<pros::Mutex> lock(mutex);
+        for (Sensor& sensor : sensors) {
+            sensor.imu.reset(false);
+            sensor.ready = false;
+            sensor.attempts = 1;
+            sensor.resetTime = pros::millis();
+            sensor.bias = 0;
+        }
+        rotation = 0;
+        rate = 0;
+        prevDelta = 0;
+        stationaryFor = 0;
+    }
+    if (task == nullptr) {
+        prevTime = pros::millis();
+        task = new pros::Task {[this] {
+            std::uint32_t now = pros::millis();
+            while (true) {
+                update();
+                pros::Task::delay_until(&now, period);
+            }
+        }};
+    }
+    while (blocking && is_calibrating()) pros::delay(10);
+    return 1;
+}
+
+std::int32_t FusedImu::set_data_rate(std::uint32_t rate) const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (sensors.empty()) return PROS_ERR;
+    // the IMUs round down to a multiple of 5ms
+    period = std::max<std::uint32_t>(rate - rate % 5, 5);
+    std::int32_t result = 1;
+    for (Sensor& sensor : sensors) {
+        if (sensor.imu.set_data_rate(period) == PROS_ERR) result = PROS_ERR;
+    }
+    return result;
+}
+
+bool FusedImu::is_calibrating() const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    bool trying = false;
+    for (const Sensor& sensor : sensors) {
+        if (sensor.ready) return false;
+        if (sensor.attempts > 0 && sensor.attempts <= settings.calibrationAttempts) trying = true;
+    }
+    return trying;
+}
+
+pros::ImuStatus FusedImu::get_status() const {
+    if (is_calibrating()) return pros::ImuStatus::calibrating;
+    return getReadyCount() > 0 ? pros::ImuStatus::ready : pros::ImuStatus::error;
+}
+
+double FusedImu::get_rotation() const {
+    if (getReadyCount() == 0) return PROS_ERR_F;
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return rotation;
+}
+
+double FusedImu::get_heading() const {
+    const double rotation = get_rotation();
+    if (rotation == PROS_ERR_F) return PROS_ERR_F;
+    const double heading = std::fmod(rotation, 360);
+    return heading < 0 ? heading + 360 : heading;
+}
+
+pros::imu_gyro_s_t FusedImu::get_gyro_rate() const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    for (const Sensor& sensor : sensors) {
+        if (!sensor.ready) continue;
+        pros::imu_gyro_s_t gyro = sensor.imu.get_gyro_rate();
+        gyro.z = rate;
+        return gyro;
+    }
+    return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+}
+
+std::int32_t FusedImu::set_rotation(double target) const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    rotation = target;
+    return 1;
+}
+
+std::int32_t FusedImu::set_heading(double target) const {
+    const double heading = get_heading();
+    if (heading == PROS_ERR_F) return PROS_ERR;
+    std::lock_guard<pros::Mutex> lock(mutex);
+    rotation += target - heading;
+    return 1;
+}
+
+std::int32_t FusedImu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t FusedImu::tare_heading() const { return set_heading(0); }
+
+std::int32_t FusedImu::tare() const { return set_rotation(0); }
+
+size_t FusedImu::getReadyCount() const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return std::count_if(sensors.begin(), sensors.end(), [](const Sensor& sensor) { return sensor.ready; });
+}
+
+float FusedImu::getBias(size_t index) const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return index < sensors.size() ? sensors[index].bias : 0;
+}
+
+bool FusedImu::isStationary() const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return stationaryFor >= settings.stationaryTime;
+}
+
+void FusedImu::update() const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    const std::uint32_t now = pros::millis();
+    const double dt = std::max<std::uint32_t>(now - prevTime, 1) / 1000.0;
+    prevTime = now;
+
+    // change in rotation of every working IMU
+    std::array<double, MAX_IMUS> deltas;
+    std::array<double, MAX_IMUS> rawDeltas;
+    std::array<Sensor*, MAX_IMUS> used;
+    size_t count = 0;
+    bool still = true;
+    for (Sensor& sensor : sensors) {
+        if (!sensor.ready) {
+            // wait for the calibration to finish, and retry if it failed
+            if (sensor.attempts == 0 || sensor.attempts > settings.calibrationAttempts) continue;
+            if (now - sensor.resetTime < CALIBRATION_START_TIME || sensor.imu.is_calibrating()) continue;
+            const double current = sensor.imu.get_rotation();
+            if (std::isfinite(current)) {
+                sensor.ready = true;
+                sensor.prevRotation = current;
+                // in case calibrating set the rate back to the default
+                sensor.imu.set_data_rate(period);
+            } else if (++sensor.attempts <= settings.calibrationAttempts) {
+                sensor.imu.reset(false);
+                sensor.resetTime = now;
+            }
+            continue;
+        }
+        const double current = sensor.imu.get_rotation();
+        // skip IMUs that are disconnected
+        if (!std::isfinite(current) || count == MAX_IMUS) continue;
+        const pros::imu_gyro_s_t gyro = sensor.imu.get_gyro_rate();
+        if (!std::isfinite(gyro.z) || std::fabs(gyro.z) > settings.stationaryRate) still = false;
+        rawDeltas[count] = current - sensor.prevRotation;
+        deltas[count] = rawDeltas[count] - sensor.bias * dt;
+        used[count] = &sensor;
+        sensor.prevRotation = current;
+        count++;
+    }
+    if (count == 0) return;
+
+    // a slow arc turns slower than stationaryRate, so the robot also has to not be driving
+    const lemlib::Pose speed = robot::getSpeed();
+    if (std::hypot(speed.x, speed.y) > settings.stationarySpeed || !motorsStill()) still = false;
+    stationaryFor = still ? stationaryFor + static_cast<int>(dt * 1000) : 0;
+    if (stationaryFor >= settings.stationaryTime) {
+        // hold the heading, and measure how much each IMU drifts
+        for (size_t i = 0; i < count; i++) {
+            used[i]->bias += settings.biasGain * (rawDeltas[i] / dt - used[i]->bias);
+        }
+        rate = 0;
+        prevDelta = 0;
+        return;
+    }
+    const double delta = fuse(deltas.data(), count, dt);
+    rotation += delta;
+    rate = delta / dt;
+    prevDelta = delta;
+}
+
+bool FusedImu::motorsStill() const {
+    for (pros::MotorGroup* motors : {leftMotors, rightMotors}) {
+        if (motors == nullptr) continue;
+        for (int i = 0; i < motors->size(); i++) {
+            const std::int32_t voltage = motors->get_voltage(i);
+            const double velocity = motors->get_actual_velocity(i);
+            // unplugged motors report errors, and can't tell anything about the robot
+            if (voltage != PROS_ERR && std::abs(voltage) > MAX_STATIONARY_VOLTAGE) return false;
+            if (std::isfinite(velocity) && std::fabs(velocity) > settings.stationaryMotorVelocity) return false;
+        }
+    }
+    return true;
+}
+
+double FusedImu::fuse(double* deltas, size_t count, double dt) const {
+    const double tolerance = settings.maxDisagreement * dt;
+    if (count == 1) return deltas[0];
+    if (count == 2) {
+        if (std::fabs(deltas[0] - deltas[1]) <= tolerance) return (deltas[0] + deltas[1]) / 2;
+        // can't tell which one is wrong, so trust the one that's closest to the last update
+        return std::fabs(deltas[0] - prevDelta) < std::fabs(deltas[1] - prevDelta) ? deltas[0] : deltas[1];
+    }
+    // average every IMU that agrees with the median
+    std::sort(deltas, deltas + count);
+    const double median = deltas[count / 2];
+    double sum = 0;
+    int agreeing = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (std::fabs(deltas[i] - median) > tolerance) continue;
+        sum += deltas[i];
+        agreeing++;
+    }
+    return sum / agreeing;
+}
+} // namespace robot
@@ -0,0 +1,59 @@
+#include <cmath>
+#include <utility>
+#include "robot/marker.hpp"
+
+namespace robot {
+
+Marker::Marker(Trigger trigger, float value, float x, float y, std::function<void()> action,
+               std::function<bool(const MotionProgress&)> condition)
+    : trigger(trigger),
+      value(value),
+      x(x),
+      y(y),
+      action(std::move(action)),
+      condition(std::move(condition)) {}
+
+Marker Marker::atDistance(float distance, std::function<void()> action) {
+    return Marker(Trigger::DISTANCE, distance, 0, 0, std::move(action));
+}
+
+Marker Marker::atFraction(float fraction, std::function<void()> action) {
+    return Marker(Trigger::FRACTION, fraction, 0, 0, std::move(action));
+}
+
+Marker Marker::inRegion(float x, float y, float radius, std::function<void()> action) {
+    return Marker(Trigger::REGION, radius, x, y, std::move(action));
+}
+
+Marker Marker::beforeEnd(int time, std::function<void()> action) {
+    return Marker(Trigger::TIME_LEFT, time, 0, 0, std::move(action));
+}
+
+Marker Marker::when(std::function<bool(const MotionProgress&)> condition, std::function<void()> action) {
+    return Marker(Trigger::CONDITION, 0, 0, 0, std::move(action), std::move(condition));
+}
+
+bool Marker::update(const MotionProgress& progress) {
+    if (done) return false;
+    bool reached = false;
+    switch (trigger) {
+        case Trigger::DISTANCE: reached = progress.traveled >= value; break;
+        case Trigger::FRACTION: {
+            const float total = progress.traveled + progress.remaining;
+            reached = total > 0 && progress.traveled / total >= value;
+            break;
+        }
+        case Trigger::REGION: reached = std::hypot(progress.pose.x - x, progress.pose.y - y) <= value; break;
+        case Trigger::TIME_LEFT: reached = progress.timeLeft >= 0 && progress.timeLeft <= value; break;
+        case Trigger::CONDITION: reached = condition && condition(progress); break;
+    }
+    if (!reached) return false;
+    done = true;
+    if (action) action();
+    return true;
+}
+
+void updateMarkers(Markers& markers, const MotionProgress& progress) {
+    for (Marker& marker : markers) marker.update(progress);
+}
+} // namespace robot
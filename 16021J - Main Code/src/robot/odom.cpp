@@ -0,0 +1,77 @@
+#include <mutex>
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include "robot/odom.hpp"
+#include "robot/seqlock.hpp"
+
+namespace robot {
+
+// lemlib::update() calculates the speed as if it runs every 10ms
+constexpr int LEMLIB_PERIOD = 10;
+
+// lemlib::Pose has no default constructor, which Seqlock needs
+struct PoseSnapshot {
+        float x;
+        float y;
+        float theta;
+};
+
+static int odomPeriod = LEMLIB_PERIOD;
+static pros::Task* odomTask = nullptr;
+static PoseHistory history;
+static Seqlock<PoseSnapshot> snapshot;
+// held by anything that changes the LemLib pose, so the snapshot always matches it. Readers never take it
+static pros::Mutex writeMutex;
+
+static void publish() {
+    const lemlib::Pose pose = lemlib::getPose(true);
+    snapshot.store({pose.x, pose.y, pose.theta});
+}
+
+void startOdom(int period) {
+    if (odomTask != nullptr) return;
+    odomPeriod = period;
+    odomTask = new pros::Task {[] {
+        std::uint32_t now = pros::millis();
+        while (true) {
+            {
+                std::lock_guard<pros::Mutex> lock(writeMutex);
+                lemlib::update();
+                publish();
+                history.push(pros::millis(), lemlib::getPose(true));
+            }
+            pros::Task::delay_until(&now, odomPeriod);
+        }
+    }};
+}
+
+int getOdomPeriod() { return odomPeriod; }
+
+lemlib::Pose getPose(bool radians, bool standardPos) {
+    const PoseSnapshot pose = snapshot.load();
+    float theta = standardPos ? M_PI_2 - pose.theta : pose.theta;
+    return {pose.x, pose.y, radians ? theta : lemlib::radToDeg(theta)};
+}
+
+void setPose(lemlib::Pose pose, bool radians) {
+    std::lock_guard<pros::Mutex> lock(writeMutex);
+    lemlib::setPose(pose, radians);
+    publish();
+}
+
+void correctPose(lemlib::Pose correction) {
+    std::lock_guard<pros::Mutex> lock(writeMutex);
+    const lemlib::Pose pose = lemlib::getPose(true);
+    lemlib::setPose({pose.x + correction.x, pose.y + correction.y, pose.theta + correction.theta}, true);
+    publish();
+}
+
+const PoseHistory& getPoseHistory() { return history; }
+
+lemlib::Pose getSpeed(bool radians) {
+    const lemlib::Pose speed = lemlib::getSpeed(radians);
+    const float scale = float(LEMLIB_PERIOD) / odomPeriod;
+    return {speed.x * scale, speed.y * scale, speed.theta * scale};
+}
+} // namespace robot
@@ -0,0 +1,207 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "pros/misc.hpp"
+#include "robot/params.hpp"
+
+namespace robot {
+
+constexpr char MAGIC[4] = {'R', 'P', 'R', 'M'};
+constexpr size_t HEADER_SIZE = 12;
+constexpr size_t ENTRY_SIZE = 9;
+constexpr size_t CRC_SIZE = 4;
+constexpr size_t MAX_FILE_SIZE = HEADER_SIZE + ParamStore::MAX_PARAMS * ENTRY_SIZE + CRC_SIZE;
+constexpr int SLOTS = 2;
+constexpr int MAX_PATH = 64;
+
+// FNV-1a, so names don't have to be stored in the file
+static std::uint32_t hashName(const char* name) {
+    std::uint32_t hash = 2166136261u;
+    for (; *name != '\0'; name++) {
+        hash ^= static_cast<std::uint8_t>(*name);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// the same CRC32 as zlib. Bitwise, the files are small and only read at startup
+static std::uint32_t crc32(const std::uint8_t* data, size_t size) {
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
+
+// little endian, whatever the compiler does with struct padding
+static void write16(std::uint8_t* out, std::uint16_t value) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+static void write32(std::uint8_t* out, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static std::uint16_t read16(const std::uint8_t* in) { return in[0] | (in[1] << 8); }
+
+static std::uint32_t read32(const std::uint8_t* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+ParamStore::ParamStore(std::uint16_t schemaVersion, const char* path)
+    : schemaVersion(schemaVersion),
+      path(path) {}
+
+void ParamStore::add(Entry entry) {
+    if (count >= MAX_PARAMS) {
+        std::printf("error too many parameters, %s is not saved\n", entry.name);
+        return;
+    }
+    entry.hash = hashName(entry.name);
+    entries[count++] = entry;
+}
+
+bool ParamStore::read(int slot, std::uint32_t& fileGeneration, bool apply) {
+    char name[MAX_PATH];
+    std::snprintf(name, sizeof(name), "%s.%d", path, slot);
+    FILE* file = std::fopen(name, "rb");
+    if (file == nullptr) return false;
+    std::uint8_t data[MAX_FILE_SIZE];
+    const size_t size = std::fread(data, 1, sizeof(data), file);
+    std::fclose(file);
+
+    if (size < HEADER_SIZE + CRC_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) return false;
+    if (read16(data + 4) != schemaVersion) return false;
+    const size_t saved = read16(data + 6);
+    if (size != HEADER_SIZE + saved * ENTRY_SIZE + CRC_SIZE) return false;
+    if (crc32(data, size - CRC_SIZE) != read32(data + size - CRC_SIZE)) return false;
+    fileGeneration = read32(data + 8);
+    if (!apply) return true;
+
+    for (size_t i = 0; i < saved; i++) {
+        const std::uint8_t* in = data + HEADER_SIZE + i * ENTRY_SIZE;
+        const std::uint32_t hash = read32(in);
+        for (size_t j = 0; j < count; j++) {
+            // a parameter that changed type keeps its default
+            if (entries[j].hash != hash || static_cast<std::uint8_t>(entries[j].type) != in[4]) continue;
+            entries[j].bits->store(read32(in + 5), std::memory_order_relaxed);
+            if (entries[j].onChange != nullptr) entries[j].onChange();
+        }
+    }
+    return true;
+}
+
+bool ParamStore::load() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (!pros::usd::is_installed()) return false;
+    newestSlot = -1;
+    for (int slot = 0; slot < SLOTS; slot++) {
+        std::uint32_t slotGeneration = 0;
+        if (!read(slot, slotGeneration, false)) continue;
+        if (newestSlot == -1 || slotGeneration > generation) {
+            newestSlot = slot;
+            generation = slotGeneration;
+        }
+    }
+    if (newestSlot == -1) return false;
+    return read(newestSlot, generation, true);
+}
+
+bool ParamStore::save() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (!pros::usd::is_installed()) return false;
+    std::uint8_t data[MAX_FILE_SIZE];
+    std::memcpy(data, MAGIC, sizeof(MAGIC));
+    write16(data + 4, schemaVersion);
+    write16(data + 6, count);
+    write32(data + 8, generation + 1);
+    for (size_t i = 0; i < count; i++) {
+        std::uint8_t* out = data + HEADER_SIZE + i * ENTRY_SIZE;
+        write32(out, entries[i].hash);
+        out[4] = static_cast<std::uint8_t>(entries[i].type);
+        write32(out + 5, entries[i].bits->load(std::memory_order_relaxed));
+    }
+    const size_t size = HEADER_SIZE + count * ENTRY_SIZE;
+    write32(data + size, crc32(data, size));
+
+    // overwrite the older save, so the newest one survives if this is interrupted
+    const int slot = newestSlot == 0 ? 1 : 0;
+    char name[MAX_PATH];
+    std::snprintf(name, sizeof(name), "%s.%d", path, slot);
+    FILE* file = std::fopen(name, "wb");
+    if (file == nullptr) return false;
+    const bool written = std::fwrite(data, 1, size + CRC_SIZE, file) == size + CRC_SIZE;
+    // the data only reaches the card once the file is closed
+    if (std::fclose(file) != 0 || !written) return false;
+    newestSlot = slot;
+    generation++;
+    return true;
+}
+
+void ParamStore::reset() {
+    for (size_t i = 0; i < count; i++) {
+        entries[i].bits->store(entries[i].defaultBits, std::memory_order_relaxed);
+        if (entries[i].onChange != nullptr) entries[i].onChange();
+    }
+}
+
+bool ParamStore::set(const char* name, const char* value) {
+    for (size_t i = 0; i < count; i++) {
+        if (std::strcmp(entries[i].name, name) != 0) continue;
+        char* end = nullptr;
+        std::uint32_t bits;
+        if (entries[i].type == ParamType::FLOAT) {
+            const float parsed = std::strtof(value, &end);
+            std::memcpy(&bits, &parsed, sizeof(bits));
+        } else {
+            bits = static_cast<std::uint32_t>(static_cast<std::int32_t>(std::strtol(value, &end, 0)));
+        }
+        if (end == value || *end != '\0') return false;
+        entries[i].bits->store(bits, std::memory_order_relaxed);
+        if (entries[i].onChange != nullptr) entries[i].onChange();
+        return true;
+    }
+    return false;
+}
+
+void ParamStore::print(const Entry& entry) const {
+    const std::uint32_t bits = entry.bits->load(std::memory_order_relaxed);
+    if (entry.type == ParamType::FLOAT) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        std::printf("param %s %g\n", entry.name, value);
+    } else {
+        std::printf("param %s %d\n", entry.name, static_cast<int>(static_cast<std::int32_t>(bits)));
+    }
+}
+
+bool ParamStore::handle(const char* command) {
+    char name[48];
+    char value[24];
+    if (std::strcmp(command, "param list") == 0) {
+        for (size_t i = 0; i < count; i++) print(entries[i]);
+    } else if (std::sscanf(command, "param set %47s %23s", name, value) == 2) {
+        if (!set(name, value)) {
+            std::printf("error can't set %s to %s\n", name, value);
+            return true;
+        }
+        for (size_t i = 0; i < count; i++)
+            if (std::strcmp(entries[i].name, name) == 0) print(entries[i]);
+    } else if (std::strcmp(command, "param save") == 0) {
+        if (save()) std::printf("param saved\n");
+        else std::printf("error can't save, is there an SD card?\n");
+    } else if (std::strcmp(command, "param reset") == 0) {
+        reset();
+        std::printf("param reset\n");
+    } else if (std::strncmp(command, "param ", 6) == 0 || std::strcmp(command, "param") == 0) {
+        std::printf("error unknown command %s\n", command);
+    } else {
+        return false;
+    }
+    return true;
+}
+} // namespace robot
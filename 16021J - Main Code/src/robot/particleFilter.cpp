@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cmath>
+#include "pros/error.h"
+#include "lemlib/util.hpp"
+#include "robot/odom.hpp"
+#include "robot/fieldMap.hpp"
+#include "robot/particleFilter.hpp"
+
+namespace robot {
+
+// faster than the robot can drive, in inches per millisecond. A larger jump means the pose was set by the user
+constexpr float MAX_SPEED = 0.15;
+// noise added every update even when the robot doesn't move, so the particles don't collapse to one point
+constexpr float MIN_POSITION_NOISE = 0.05;
+constexpr float MIN_HEADING_NOISE = 0.002;
+// squared error of a reading is capped at this, so one sensor seeing another robot can't rule out every particle
+constexpr float MAX_SQUARED_ERROR = 9;
+
+ParticleFilter::ParticleFilter(ParticleFilterSettings settings)
+    : settings(settings),
+      xs(settings.particles),
+      ys(settings.particles),
+      thetas(settings.particles),
+      weights(settings.particles, 1.0f / settings.particles),
+      nextXs(settings.particles),
+      nextYs(settings.particles),
+      nextThetas(settings.particles) {}
+
+bool ParticleFilter::addWallSensor(WallSensor sensor) {
+    if (wallCount >= MAX_WALL_SENSORS) return false;
+    walls[wallCount++] = sensor;
+    return true;
+}
+
+void ParticleFilter::setSlipDetector(const SlipDetector* detector) { slipDetector = detector; }
+
+void ParticleFilter::start() {
+    if (task != nullptr) return;
+    reset();
+    task = new pros::Task {[this] {
+                               std::uint32_t now = pros::millis();
+                               while (true) {
+                                   update();
+                                   pros::Task::delay_until(&now, settings.period);
+                               }
+                           },
+                           TASK_PRIORITY_DEFAULT - 2};
+}
+
+void ParticleFilter::update() {
+    const std::uint64_t start = pros::micros();
+    predict(robot::getPose(true));
+    if (weigh()) {
+        estimate();
+        resample();
+        publish();
+    }
+    const float elapsed = std::max<std::uint64_t>(pros::micros() - start, 1);
+    particlesPerSecond = xs.size() * 1e6f / elapsed;
+}
+
+void ParticleFilter::reset(float positionStdDev, float headingStdDev) {
+    prevOdom = robot::getPose(true);
+    pose = prevOdom;
+    const float headingStdDevRad = lemlib::degToRad(headingStdDev);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i] = prevOdom.x + gaussian() * positionStdDev;
+        ys[i] = prevOdom.y + gaussian() * positionStdDev;
+        thetas[i] = prevOdom.theta + gaussian() * headingStdDevRad;
+    }
+    std::fill(weights.begin(), weights.end(), 1.0f / weights.size());
+}
+
+lemlib::Pose ParticleFilter::getPose(bool radians) const {
+    return {pose.x, pose.y, radians ? pose.theta : lemlib::radToDeg(pose.theta)};
+}
+
+float ParticleFilter::getParticlesPerSecond() const { return particlesPerSecond; }
+
+void ParticleFilter::predict(const lemlib::Pose& odom) {
+    const float dx = odom.x - prevOdom.x;
+    const float dy = odom.y - prevOdom.y;
+    const float dTheta = odom.theta - prevOdom.theta;
+    const float dist = std::hypot(dx, dy);
+    // the pose was set with setPose, start over from it
+    if (dist > MAX_SPEED * settings.period || std::fabs(dTheta) > M_PI_2) {
+        reset();
+        return;
+    }
+
+    // displacement in the frame of the robot, x is right and y is forward
+    const float odomHeading = prevOdom.theta + dTheta / 2;
+    const float right = dx * std::cos(odomHeading) - dy * std::sin(odomHeading);
+    const float forward = dx * std::sin(odomHeading) + dy * std::cos(odomHeading);
+    // spread the particles further while the wheels are slipping
+    const float scale = slipDetector != nullptr ? slipDetector->getOdomNoiseScale() : 1;
+    const float positionNoise = settings.odomDrift * dist * scale + MIN_POSITION_NOISE;
+    const float headingNoise = settings.headingDrift * std::fabs(dTheta) * scale + MIN_HEADING_NOISE;
+
+    for (size_t i = 0; i < xs.size(); i++) {
+        const float r = right + gaussian() * positionNoise;
+        const float f = forward + gaussian() * positionNoise;
+        const float heading = thetas[i] + dTheta / 2;
+        const float sin = std::sin(heading);
+        const float cos = std::cos(heading);
+        xs[i] += r * cos + f * sin;
+        ys[i] += -r * sin + f * cos;
+        thetas[i] += dTheta + gaussian() * headingNoise;
+    }
+    prevOdom = odom;
+}
+
+bool ParticleFilter::weigh() {
+    // read every sensor once
+    std::array<float, MAX_WALL_SENSORS> readings;
+    std::array<const WallSensor*, MAX_WALL_SENSORS> sensors;
+    size_t count = 0;
+    for (size_t i = 0; i < wallCount; i++) {
+        const std::int32_t reading = walls[i].sensor->get_distance();
+        if (reading == PROS_ERR || reading <= 0 || reading >= 2000) continue;
+        if (walls[i].sensor->get_confidence() < settings.distanceMinConfidence) continue;
+        readings[count] = reading / 25.4f;
+        sensors[count] = &walls[i];
+        count++;
+    }
+    if (count == 0) return false;
+
+    // log likelihood of the readings for each particle, stored in the resampling scratch space
+    std::vector<float>& logLikelihoods = nextXs;
+    float maxLogLikelihood = -INFINITY;
+    for (size_t i = 0; i < xs.size(); i++) {
+        const float sin = std::sin(thetas[i]);
+        const float cos = std::cos(thetas[i]);
+        float logLikelihood = 0;
+        for (size_t k = 0; k < count; k++) {
+            const WallSensor& wall = *sensors[k];
+            const float x = xs[i] + wall.x * cos + wall.y * sin;
+            const float y = ys[i] - wall.x * sin + wall.y * cos;
+            const float expected = fieldDistance(x, y, thetas[i] + lemlib::degToRad(wall.angle));
+            const float stdDev = settings.distanceStdDev * readings[k] + 0.5f;
+            const float error = (readings[k] - expected) / stdDev;
+            logLikelihood -= 0.5f * std::min(error * error, MAX_SQUARED_ERROR);
+        }
+        logLikelihoods[i] = logLikelihood;
+        maxLogLikelihood = std::max(maxLogLikelihood, logLikelihood);
+    }
+
+    float sum = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        weights[i] *= std::exp(logLikelihoods[i] - maxLogLikelihood);
+        sum += weights[i];
+    }
+    if (sum <= 0 || !std::isfinite(sum)) {
+        std::fill(weights.begin(), weights.end(), 1.0f / weights.size());
+        return true;
+    }
+    for (float& weight : weights) weight /= sum;
+    return true;
+}
+
+void ParticleFilter::estimate() {
+    float x = 0;
+    float y = 0;
+    float theta = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        x += weights[i] * xs[i];
+        y += weights[i] * ys[i];
+        // particles are always close to the odometry heading, so there's no wrapping to worry about
+        theta += weights[i] * thetas[i];
+    }
+    pose = {x, y, theta};
+}
+
+void ParticleFilter::resample() {
+    // only resample once the weights have degenerated, to keep the particles diverse
+    float sumSquares = 0;
+    for (float weight : weights) sumSquares += weight * weight;
+    if (1 / sumSquares > xs.size() / 2.0f) return;
+
+    // low variance resampling
+    const size_t n = xs.size();
+    const float step = 1.0f / n;
+    float target = uniform() * step;
+    float cumulative = weights[0];
+    size_t j = 0;
+    for (size_t i = 0; i < n; i++) {
+        while (target > cumulative && j < n - 1) cumulative += weights[++j];
+        nextXs[i] = xs[j];
+        nextYs[i] = ys[j];
+        nextThetas[i] = thetas[j];
+        target += step;
+    }
+    xs.swap(nextXs);
+    ys.swap(nextYs);
+    thetas.swap(nextThetas);
+    std::fill(weights.begin(), weights.end(), step);
+}
+
+void ParticleFilter::publish() {
+    const float dx = pose.x - prevOdom.x;
+    const float dy = pose.y - prevOdom.y;
+    const float dTheta = pose.theta - prevOdom.theta;
+    if (std::hypot(dx, dy) < settings.publishThreshold) return;
+    // apply the correction on top of the latest odometry pose, in case odometry updated since predict()
+    correctPose({dx, dy, dTheta});
+    prevOdom = {prevOdom.x + dx, prevOdom.y + dy, prevOdom.theta + dTheta};
+}
+
+float ParticleFilter::uniform() {
+    // xorshift32, much cheaper than the standard library generators
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (seed >> 8) * (1.0f / (1 << 24));
+}
+
+float ParticleFilter::gaussian() {
+    // sum of uniform samples, close enough to a normal distribution for motion noise
+    return (uniform() + uniform() + uniform() + uniform() - 2) * std::sqrt(3.0f);
+}
+} // namespace robot
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include "robot/path.hpp"
+
+namespace robot {
+
+// the slowest speed a segment is assumed to be driven at, out of 127. The ends of a path have a speed of 0, which
+// would take forever to drive
+constexpr float MIN_SPEED = 1;
+
+Path::Path(const asset& path) {
+    const char* data = reinterpret_cast<const char*>(path.buf);
+    size_t pos = 0;
+    // the asset isn't null terminated, so each line is copied into a small buffer before parsing
+    char line[64];
+    while (pos < path.size) {
+        size_t len = 0;
+        while (pos < path.size && data[pos] != '\n') {
+            if (len < sizeof(line) - 1) line[len++] = data[pos];
+            pos++;
+        }
+        pos++; // skip the newline
+        line[len] = '\0';
+        // everything after endData is path.jerryio metadata
+        if (std::strncmp(line, "endData", 7) == 0) break;
+        // lines are formatted as "x, y, speed"
+        char* end;
+        const float x = std::strtof(line, &end);
+        if (end == line || *end != ',') continue;
+        char* start = end + 1;
+        const float y = std::strtof(start, &end);
+        if (end == start || *end != ',') continue;
+        start = end + 1;
+        const float speed = std::strtof(start, &end);
+        if (end == start) continue;
+        points.push_back({x, y, speed, 0, 0});
+    }
+    annotate();
+}
+
+Path::Path(std::vector<PathPoint> points)
+    : points(std::move(points)) {
+    annotate();
+}
+
+void Path::annotate() {
+    for (size_t i = 0; i < points.size(); i++) {
+        // cumulative distance, and time at a top speed of 1 inch per second
+        if (i == 0) {
+            points[i].distance = 0;
+            points[i].time = 0;
+        } else {
+            const float segment = std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+            const float speed = std::max((points[i - 1].speed + points[i].speed) / 2, MIN_SPEED) / 127;
+            points[i].distance = points[i - 1].distance + segment;
+            points[i].time = points[i - 1].time + segment / speed;
+        }
+        // curvature of the circle through this point and its neighbours
+        points[i].curvature = 0;
+        if (i == 0 || i + 1 >= points.size()) continue;
+        const PathPoint& a = points[i - 1];
+        const PathPoint& b = points[i];
+        const PathPoint& c = points[i + 1];
+        const float ab = std::hypot(b.x - a.x, b.y - a.y);
+        const float bc = std::hypot(c.x - b.x, c.y - b.y);
+        const float ca = std::hypot(a.x - c.x, a.y - c.y);
+        const float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        const float denominator = ab * bc * ca;
+        if (denominator > 1e-6) points[i].curvature = 2 * cross / denominator;
+    }
+    // the path ends at the first point of the trailing run of stopped points
+    size_t last = points.size();
+    while (last > 1 && points[last - 1].speed == 0 && points[last - 2].speed == 0) last--;
+    endDistance = last == 0 ? 0 : points[last - 1].distance;
+    endTime = last == 0 ? 0 : points[last - 1].time;
+}
+
+size_t Path::size() const { return points.size(); }
+
+const PathPoint& Path::operator[](size_t index) const { return points[index]; }
+
+float Path::length() const { return endDistance; }
+
+size_t Path::closestIndex(lemlib::Pose pose, size_t start, size_t window) const {
+    size_t closest = start;
+    float closestDist = INFINITY;
+    const size_t end = std::min(points.size(), start + window);
+    for (size_t i = start; i < end; i++) {
+        const float dist = std::hypot(points[i].x - pose.x, points[i].y - pose.y);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+size_t Path::indexAt(float distance, size_t hint) const {
+    if (points.empty()) return 0;
+    size_t i = std::min(hint, points.size() - 1);
+    while (i + 1 < points.size() && points[i + 1].distance <= distance) i++;
+    return i;
+}
+
+lemlib::Pose Path::sample(float distance, size_t hint) const {
+    if (points.empty()) return {0, 0, 0};
+    distance = std::clamp(distance, 0.0f, points.back().distance);
+    const size_t i = indexAt(distance, hint);
+    const PathPoint& a = points[i];
+    if (i + 1 >= points.size()) return {a.x, a.y, a.speed};
+    const PathPoint& b = points[i + 1];
+    const float segment = b.distance - a.distance;
+    const float t = segment > 1e-6 ? (distance - a.distance) / segment : 0;
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.speed + (b.speed - a.speed) * t};
+}
+
+float Path::maxCurvature(float from, float to, size_t hint) const {
+    float max = 0;
+    for (size_t i = indexAt(from, hint); i < points.size() && points[i].distance <= to; i++)
+        max = std::max(max, std::fabs(points[i].curvature));
+    return max;
+}
+
+float Path::timeAt(float distance, size_t hint) const {
+    const size_t i = indexAt(distance, hint);
+    const PathPoint& a = points[i];
+    if (i + 1 >= points.size()) return a.time;
+    const PathPoint& b = points[i + 1];
+    const float segment = b.distance - a.distance;
+    const float t = segment > 1e-6 ? std::clamp((distance - a.distance) / segment, 0.0f, 1.0f) : 0;
+    return a.time + (b.time - a.time) * t;
+}
+
+float Path::duration(float maxVelocity, float from, size_t hint) const {
+    if (points.empty() || from >= endDistance) return 0;
+    return (endTime - timeAt(std::max(from, 0.0f), hint)) / maxVelocity;
+}
+} // namespace robot
@@ -0,0 +1,31 @@
+#include <cmath>
+#include "lemlib/util.hpp"
+#include "robot/pid.hpp"
+
+namespace robot {
+
+PID::PID(float kP, float kI, float kD, float windupRange, bool signFlipReset)
+    : signFlipReset(signFlipReset) {
+    gains.store({kP, kI, kD, windupRange});
+}
+
+float PID::update(float error) {
+    // read every gain at once, so a change can't land halfway through the calculation
+    const PIDGains current = gains.load();
+    integral += error;
+    if (lemlib::sgn(error) != lemlib::sgn(prevError) && signFlipReset) integral = 0;
+    if (std::fabs(error) > current.windupRange && current.windupRange != 0) integral = 0;
+    const float derivative = error - prevError;
+    prevError = error;
+    return error * current.kP + integral * current.kI + derivative * current.kD;
+}
+
+void PID::reset() {
+    integral = 0;
+    prevError = 0;
+}
+
+void PID::setGains(PIDGains gains) { this->gains.store(gains); }
+
+PIDGains PID::getGains() const { return gains.load(); }
+} // namespace robot
@@ -0,0 +1,199 @@
+#include <cmath>
+#include "pros/error.h"
+#include "lemlib/util.hpp"
+#include "robot/odom.hpp"
+#include "robot/poseEstimator.hpp"
+
+namespace robot {
+
+// meters to inches
+constexpr float M_TO_IN = 39.3701;
+// odometry can't move further than this in one tick, so a larger jump means the pose was set by the user
+constexpr float MAX_STEP = 6;
+// heading corrections smaller than this aren't written back to odometry, in radians
+constexpr float HEADING_PUBLISH_THRESHOLD = 0.01;
+
+PoseEstimator::PoseEstimator(pros::Gps* gps, EstimatorSettings settings)
+    : gps(gps),
+      settings(settings),
+      covariance(Matrix<3, 3>::identity()) {}
+
+bool PoseEstimator::addWallSensor(WallSensor sensor) {
+    if (wallCount >= MAX_WALL_SENSORS) return false;
+    walls[wallCount++] = sensor;
+    return true;
+}
+
+void PoseEstimator::setSlipDetector(const SlipDetector* detector) { slipDetector = detector; }
+
+void PoseEstimator::start() {
+    if (task != nullptr) return;
+    reset();
+    task = new pros::Task {[this] {
+        std::uint32_t now = pros::millis();
+        while (true) {
+            update();
+            pros::Task::delay_until(&now, 10);
+        }
+    }};
+}
+
+void PoseEstimator::update() {
+    predict(robot::getPose(true));
+    updateGps();
+    for (size_t i = 0; i < wallCount; i++) updateWall(walls[i]);
+    publish();
+}
+
+void PoseEstimator::reset(float positionStdDev, float headingStdDev) {
+    prevOdom = robot::getPose(true);
+    state(0, 0) = prevOdom.x;
+    state(1, 0) = prevOdom.y;
+    state(2, 0) = prevOdom.theta;
+    covariance = Matrix<3, 3>();
+    covariance(0, 0) = positionStdDev * positionStdDev;
+    covariance(1, 1) = positionStdDev * positionStdDev;
+    covariance(2, 2) = std::pow(lemlib::degToRad(headingStdDev), 2);
+}
+
+lemlib::Pose PoseEstimator::getPose(bool radians) const {
+    return {state(0, 0), state(1, 0), radians ? state(2, 0) : lemlib::radToDeg(state(2, 0))};
+}
+
+Matrix<3, 3> PoseEstimator::getCovariance() const { return covariance; }
+
+void PoseEstimator::predict(const lemlib::Pose& odom) {
+    const float dx = odom.x - prevOdom.x;
+    const float dy = odom.y - prevOdom.y;
+    const float dTheta = odom.theta - prevOdom.theta;
+    const float dist = std::hypot(dx, dy);
+    // the pose was set with setPose, start over from it
+    if (dist > MAX_STEP || std::fabs(dTheta) > M_PI_4) {
+        reset();
+        return;
+    }
+
+    // displacement in the frame of the robot, x is right and y is forward
+    const float odomHeading = prevOdom.theta + dTheta / 2;
+    const float right = dx * std::cos(odomHeading) - dy * std::sin(odomHeading);
+    const float forward = dx * std::sin(odomHeading) + dy * std::cos(odomHeading);
+
+    // apply the displacement at the filtered heading
+    const float heading = state(2, 0) + dTheta / 2;
+    const float sin = std::sin(heading);
+    const float cos = std::cos(heading);
+    state(0, 0) += right * cos + forward * sin;
+    state(1, 0) += -right * sin + forward * cos;
+    state(2, 0) += dTheta;
+
+    // heading error turns into position error as the robot moves
+    Matrix<3, 3> jacobian = Matrix<3, 3>::identity();
+    jacobian(0, 2) = -right * sin + forward * cos;
+    jacobian(1, 2) = -right * cos - forward * sin;
+    // trust odometry less while the wheels are slipping
+    const float scale = slipDetector != nullptr ? slipDetector->getOdomNoiseScale() : 1;
+    Matrix<3, 3> noise;
+    noise(0, 0) = std::pow(settings.odomDrift * dist * scale, 2) + 1e-6f;
+    noise(1, 1) = noise(0, 0);
+    noise(2, 2) = std::pow(settings.headingDrift * dTheta * scale, 2) + 1e-8f;
+    covariance = jacobian * covariance * jacobian.transpose() + noise;
+    prevOdom = odom;
+}
+
+void PoseEstimator::updateGps() {
+    if (gps == nullptr) return;
+    const float error = gps->get_error();
+    if (error == PROS_ERR_F || error > settings.gpsMaxError) return;
+    const pros::gps_status_s_t status = gps->get_position_and_orientation();
+    if (status.x == PROS_ERR_F) return;
+
+    Matrix<3, 1> innovation;
+    innovation(0, 0) = status.x * M_TO_IN - state(0, 0);
+    innovation(1, 0) = status.y * M_TO_IN - state(1, 0);
+    innovation(2, 0) = lemlib::angleError(lemlib::degToRad(status.yaw), state(2, 0));
+    Matrix<3, 3> measurementNoise;
+    measurementNoise(0, 0) = std::pow(std::fmax(error, 0.005f) * M_TO_IN, 2);
+    measurementNoise(1, 1) = measurementNoise(0, 0);
+    measurementNoise(2, 2) = std::pow(lemlib::degToRad(settings.gpsHeadingStdDev), 2);
+
+    // the measurement is the state itself, so H is the identity
+    Matrix<3, 3> inverse;
+    if (!invert(covariance + measurementNoise, inverse)) return;
+    // reject readings that are too far from where the filter thinks the robot is
+    if ((innovation.transpose() * inverse * innovation)(0, 0) > settings.gate) return;
+    const Matrix<3, 3> gain = covariance * inverse;
+    state = state + gain * innovation;
+    covariance = (Matrix<3, 3>::identity() - gain) * covariance;
+}
+
+float PoseEstimator::expectedWallDistance(const Matrix<3, 1>& pose, const WallSensor& wall) const {
+    // position and direction of the sensor on the field
+    const float heading = pose(2, 0);
+    const float x = pose(0, 0) + wall.x * std::cos(heading) + wall.y * std::sin(heading);
+    const float y = pose(1, 0) - wall.x * std::sin(heading) + wall.y * std::cos(heading);
+    const float direction = heading + lemlib::degToRad(wall.angle);
+    const float dirX = std::sin(direction);
+    const float dirY = std::cos(direction);
+
+    // distance to the first wall the sensor is pointed at
+    const float half = settings.fieldHalfWidth;
+    float distance = INFINITY;
+    float incidence = 0;
+    if (std::fabs(dirX) > 1e-3f) {
+        const float t = ((dirX > 0 ? half : -half) - x) / dirX;
+        if (t > 0 && t < distance) {
+            distance = t;
+            incidence = std::fabs(dirX);
+        }
+    }
+    if (std::fabs(dirY) > 1e-3f) {
+        const float t = ((dirY > 0 ? half : -half) - y) / dirY;
+        if (t > 0 && t < distance) {
+            distance = t;
+            incidence = std::fabs(dirY);
+        }
+    }
+    // readings at a shallow angle to the wall are unreliable
+    if (incidence < M_SQRT1_2) return -1;
+    return distance;
+}
+
+void PoseEstimator::updateWall(const WallSensor& wall) {
+    const std::int32_t reading = wall.sensor->get_distance();
+    if (reading == PROS_ERR || reading <= 0 || reading >= 2000) return;
+    if (wall.sensor->get_confidence() < settings.distanceMinConfidence) return;
+    const float measured = reading / 25.4f;
+    const float expected = expectedWallDistance(state, wall);
+    if (expected < 0) return;
+
+    // numerical jacobian of the expected distance
+    Matrix<1, 3> jacobian;
+    constexpr float steps[3] = {0.01, 0.01, 0.001};
+    for (size_t i = 0; i < 3; i++) {
+        Matrix<3, 1> shifted = state;
+        shifted(i, 0) += steps[i];
+        const float distance = expectedWallDistance(shifted, wall);
+        if (distance < 0) return;
+        jacobian(0, i) = (distance - expected) / steps[i];
+    }
+
+    const float innovation = measured - expected;
+    const float variance = (jacobian * covariance * jacobian.transpose())(0, 0) +
+                           std::pow(settings.distanceStdDev * measured, 2) + 0.25f;
+    // reject readings of something other than the wall
+    if (innovation * innovation / variance > settings.gate) return;
+    const Matrix<3, 1> gain = covariance * jacobian.transpose() * (1 / variance);
+    state = state + gain * innovation;
+    covariance = (Matrix<3, 3>::identity() - gain * jacobian) * covariance;
+}
+
+void PoseEstimator::publish() {
+    const float dx = state(0, 0) - prevOdom.x;
+    const float dy = state(1, 0) - prevOdom.y;
+    const float dTheta = state(2, 0) - prevOdom.theta;
+    if (std::hypot(dx, dy) < settings.publishThreshold && std::fabs(dTheta) < HEADING_PUBLISH_THRESHOLD) return;
+    // apply the correction on top of the latest odometry pose, in case odometry updated since predict()
+    correctPose({dx, dy, dTheta});
+    prevOdom = {prevOdom.x + dx, prevOdom.y + dy, prevOdom.theta + dTheta};
+}
+} // namespace robot
@@ -0,0 +1,67 @@
+#include "lemlib/util.hpp"
+#include "robot/poseHistory.hpp"
+
+namespace robot {
+
+// entries this close to the oldest one may be overwritten while they are read, so they aren't used
+constexpr std::uint32_t OVERWRITE_MARGIN = 4;
+
+void PoseHistory::push(std::uint32_t time, const lemlib::Pose& pose) {
+    const std::uint32_t index = count.load(std::memory_order_relaxed);
+    entries[index % CAPACITY].store({index, time, pose.x, pose.y, pose.theta});
+    count.store(index + 1, std::memory_order_release);
+}
+
+bool PoseHistory::get(std::uint32_t index, Entry& entry) const {
+    entry = entries[index % CAPACITY].load();
+    return entry.index == index;
+}
+
+std::uint32_t PoseHistory::latestTime() const {
+    const std::uint32_t n = count.load(std::memory_order_acquire);
+    Entry entry;
+    if (n == 0 || !get(n - 1, entry)) return 0;
+    return entry.time;
+}
+
+bool PoseHistory::poseAt(std::uint32_t time, lemlib::Pose& pose, bool radians) const {
+    const std::uint32_t n = count.load(std::memory_order_acquire);
+    if (n == 0) return false;
+    std::uint32_t low = n > CAPACITY - OVERWRITE_MARGIN ? n - (CAPACITY - OVERWRITE_MARGIN) : 0;
+    std::uint32_t high = n - 1;
+    Entry before;
+    Entry after;
+    if (!get(low, before) || !get(high, after)) return false;
+    if (time < before.time || time > after.time) return false;
+
+    // binary search for the entries on either side of the time
+    while (high - low > 1) {
+        const std::uint32_t middle = low + (high - low) / 2;
+        Entry entry;
+        if (!get(middle, entry)) return false;
+        if (entry.time <= time) {
+            low = middle;
+            before = entry;
+        } else {
+            high = middle;
+            after = entry;
+        }
+    }
+
+    // interpolate between them
+    const float t = after.time > before.time ? float(time - before.time) / (after.time - before.time) : 0;
+    const float theta = before.theta + (after.theta - before.theta) * t;
+    pose = {before.x + (after.x - before.x) * t, before.y + (after.y - before.y) * t,
+            radians ? theta : lemlib::radToDeg(theta)};
+    return true;
+}
+
+bool PoseHistory::velocityAt(std::uint32_t time, lemlib::Pose& velocity, int window, bool radians) const {
+    lemlib::Pose start(0, 0, 0);
+    lemlib::Pose end(0, 0, 0);
+    if (window <= 0 || !poseAt(time - window, start, radians) || !poseAt(time, end, radians)) return false;
+    const float seconds = window / 1000.0f;
+    velocity = {(end.x - start.x) / seconds, (end.y - start.y) / seconds, (end.theta - start.theta) / seconds};
+    return true;
+}
+} // namespace robot
@@ -0,0 +1,52 @@
+#include <cmath>
+#include "lemlib/util.hpp"
+#include "robot/slipClassifier.hpp"
+
+namespace robot {
+
+SlipClassifier::SlipClassifier(float trackWidth, float verticalOffset, SlipSettings settings)
+    : trackWidth(trackWidth),
+      verticalOffset(verticalOffset),
+      settings(settings) {}
+
+void SlipClassifier::update(float deltaLeft, float deltaRight, float deltaVertical, float deltaImu, float dt,
+                            std::uint32_t now) {
+    const bool imuValid = std::isfinite(deltaImu);
+    // distance and rotation according to the drive motors
+    const float driveForward = (deltaLeft + deltaRight) / 2;
+    const float driveYaw = lemlib::radToDeg((deltaLeft - deltaRight) / trackWidth);
+    // distance according to the tracking wheel, with the part caused by turning removed
+    const float heading = lemlib::degToRad(imuValid ? deltaImu : driveYaw);
+    const float trackForward = deltaVertical + verticalOffset * heading;
+
+    bool slip = false;
+    bool hit = false;
+    const float scale = std::fmax(std::fabs(driveForward), std::fabs(trackForward));
+    if (std::fabs(driveForward - trackForward) > std::fmax(settings.minDistance, settings.distanceRatio * scale)) {
+        if (std::fabs(driveForward) > std::fabs(trackForward)) slip = true;
+        else hit = true;
+    }
+    if (imuValid && std::fabs(driveYaw - deltaImu) / dt > settings.yawRateError) {
+        if (std::fabs(driveYaw) > std::fabs(deltaImu)) slip = true;
+        else hit = true;
+    }
+
+    // count each detection once, even if it lasts for several updates
+    if (slip) {
+        if (now >= slipUntil) slipCount++;
+        slipUntil = now + settings.holdTime;
+    }
+    if (hit) {
+        if (now >= collisionUntil) collisionCount++;
+        collisionUntil = now + settings.holdTime;
+    }
+}
+
+bool SlipClassifier::isSlipping(std::uint32_t now) const { return now < slipUntil; }
+
+bool SlipClassifier::isColliding(std::uint32_t now) const { return now < collisionUntil; }
+
+int SlipClassifier::getSlipCount() const { return slipCount; }
+
+int SlipClassifier::getCollisionCount() const { return collisionCount; }
+} // namespace robot
@@ -0,0 +1,83 @@
+#include <cmath>
+#include "lemlib/logger/logger.hpp"
+#include "robot/slipDetector.hpp"
+
+namespace robot {
+
+// no sensor can move this far in one update, so a larger change means it was reset, in inches
+constexpr float MAX_STEP = 3;
+
+SlipDetector::SlipDetector(lemlib::Drivetrain drivetrain, lemlib::TrackingWheel* vertical, pros::Imu* imu,
+                           SlipSettings settings)
+    : drivetrain(drivetrain),
+      leftWheel(drivetrain.leftMotors, drivetrain.wheelDiameter, -drivetrain.trackWidth / 2, drivetrain.rpm),
+      rightWheel(drivetrain.rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2, drivetrain.rpm),
+      vertical(vertical),
+      imu(imu),
+      settings(settings),
+      classifier(drivetrain.trackWidth, vertical->getOffset(), settings) {}
+
+void SlipDetector::start() {
+    if (task != nullptr) return;
+    task = new pros::Task {[this] {
+        std::uint32_t now = pros::millis();
+        while (true) {
+            update();
+            pros::Task::delay_until(&now, 10);
+        }
+    }};
+}
+
+void SlipDetector::resetBaseline() {
+    prevLeft = leftWheel.getDistanceTraveled();
+    prevRight = rightWheel.getDistanceTraveled();
+    prevVertical = vertical->getDistanceTraveled();
+    prevRotation = imu != nullptr ? imu->get_rotation() : NAN;
+    prevTime = pros::millis();
+    hasBaseline = true;
+}
+
+void SlipDetector::update() {
+    if (!hasBaseline) {
+        resetBaseline();
+        return;
+    }
+    const float left = leftWheel.getDistanceTraveled();
+    const float right = rightWheel.getDistanceTraveled();
+    const float verticalDistance = vertical->getDistanceTraveled();
+    const double rotation = imu != nullptr ? imu->get_rotation() : NAN;
+    const std::uint32_t now = pros::millis();
+    const float deltaLeft = left - prevLeft;
+    const float deltaRight = right - prevRight;
+    const float deltaVertical = verticalDistance - prevVertical;
+    const float dt = std::fmax(now - prevTime, 1) / 1000.0;
+    // the tracking wheels were reset by calibration
+    if (std::fabs(deltaLeft) > MAX_STEP || std::fabs(deltaRight) > MAX_STEP || std::fabs(deltaVertical) > MAX_STEP) {
+        resetBaseline();
+        return;
+    }
+    const float deltaImu = rotation - prevRotation;
+    prevLeft = left;
+    prevRight = right;
+    prevVertical = verticalDistance;
+    prevRotation = rotation;
+    prevTime = now;
+
+    const int slips = classifier.getSlipCount();
+    const int collisions = classifier.getCollisionCount();
+    classifier.update(deltaLeft, deltaRight, deltaVertical, deltaImu, dt, now);
+    if (classifier.getSlipCount() != slips || classifier.getCollisionCount() != collisions) {
+        lemlib::telemetrySink()->info("slip,{},{}", classifier.getSlipCount(), classifier.getCollisionCount());
+    }
+}
+
+bool SlipDetector::isSlipping() const { return classifier.isSlipping(pros::millis()); }
+
+bool SlipDetector::isColliding() const { return classifier.isColliding(pros::millis()); }
+
+int SlipDetector::getSlipCount() const { return classifier.getSlipCount(); }
+
+int SlipDetector::getCollisionCount() const { return classifier.getCollisionCount(); }
+
+float SlipDetector::getOdomNoiseScale() const { return isSlipping() || isColliding() ? settings.noiseScale : 1; }
+} // namespace robot
@@ -0,0 +1,123 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "lemlib/util.hpp"
+#include "robot/tuner.hpp"
+
+namespace robot {
+
+// longest command that's accepted, longer lines are cut off
+constexpr int MAX_COMMAND = 96;
+constexpr int DEFAULT_TEST_TIMEOUT = 3000;
+
+Tuner::Tuner(Chassis& chassis, ParamStore* params)
+    : chassis(chassis),
+      params(params) {}
+
+void Tuner::start() {
+    if (task != nullptr) return;
+    task = new pros::Task {[this] {
+        char command[MAX_COMMAND];
+        while (true) {
+            // blocks until a line is sent
+            if (std::fgets(command, sizeof(command), stdin) == nullptr) {
+                pros::delay(50);
+                continue;
+            }
+            command[std::strcspn(command, "\r\n")] = '\0';
+            handle(command);
+        }
+    }};
+}
+
+void Tuner::handle(const char* command) {
+    char name[16];
+    float amount = 0;
+    int timeout = DEFAULT_TEST_TIMEOUT;
+    if (params != nullptr && params->handle(command)) return;
+    if (std::strcmp(command, "get") == 0) {
+        printGains();
+    } else if (std::sscanf(command, "set %15s", name) == 1) {
+        const bool lateral = std::strcmp(name, "lateral") == 0;
+        if (!lateral && std::strcmp(name, "angular") != 0) {
+            std::printf("error unknown controller %s\n", name);
+            return;
+        }
+        // windupRange is optional, so start from the current gains to keep it when it's left out
+        PIDGains gains = lateral ? chassis.getLateralGains() : chassis.getAngularGains();
+        if (std::sscanf(command, "set %15s %f %f %f %f", name, &gains.kP, &gains.kI, &gains.kD,
+                        &gains.windupRange) < 4) {
+            std::printf("error expected set %s <kP> <kI> <kD> [windupRange]\n", name);
+            return;
+        }
+        if (lateral) chassis.setLateralGains(gains);
+        else chassis.setAngularGains(gains);
+        printGains();
+    } else if (std::sscanf(command, "test %15s %f %d", name, &amount, &timeout) >= 2) {
+        if (std::strcmp(name, "lateral") == 0) test(true, amount, timeout);
+        else if (std::strcmp(name, "angular") == 0) test(false, amount, timeout);
+        else std::printf("error unknown controller %s\n", name);
+    } else if (command[0] != '\0') {
+        std::printf("error unknown command %s\n", command);
+    }
+}
+
+bool Tuner::isTesting() const { return testing; }
+
+void Tuner::printGains() {
+    const PIDGains lateral = chassis.getLateralGains();
+    const PIDGains angular = chassis.getAngularGains();
+    std::printf("gains lateral %g %g %g %g\n", lateral.kP, lateral.kI, lateral.kD, lateral.windupRange);
+    std::printf("gains angular %g %g %g %g\n", angular.kP, angular.kI, angular.kD, angular.windupRange);
+}
+
+void Tuner::test(bool lateral, float amount, int timeout) {
+    if (!chassis.isCalibrated()) {
+        std::printf("error not calibrated\n");
+        return;
+    }
+    if (chassis.isInMotion()) {
+        std::printf("error a motion is already running\n");
+        return;
+    }
+
+    testing = true; // driver control leaves the drivetrain alone until the test is done
+    // record this motion, then give the log back to whatever was recording before
+    TuningLog* previous = chassis.getTuningLog();
+    TuningSample sample;
+    while (log.pop(sample)) {} // drop anything left over from the last test
+    chassis.setTuningLog(&log);
+
+    const lemlib::Pose pose = chassis.getPose();
+    if (lateral) {
+        const float heading = lemlib::degToRad(pose.theta);
+        chassis.moveToPoint(pose.x + amount * std::sin(heading), pose.y + amount * std::cos(heading), timeout,
+                            {.forwards = amount >= 0});
+    } else {
+        chassis.turnToHeading(pose.theta + amount, timeout);
+    }
+
+    const std::uint32_t start = pros::millis();
+    // motions record a sample every 10ms
+    int time = 0;
+    auto print = [&] {
+        while (log.pop(sample)) {
+            if (lateral)
+                std::printf("sample %d %.3f %.2f %.2f\n", time, sample.lateralError, sample.lateralOutput,
+                            sample.velocity);
+            else
+                std::printf("sample %d %.3f %.2f %.2f\n", time, sample.angularError, sample.angularOutput,
+                            sample.angularVelocity);
+            time += 10;
+        }
+    };
+    while (chassis.isInMotion()) {
+        print();
+        pros::delay(10);
+    }
+    print();
+    chassis.setTuningLog(previous);
+    testing = false;
+    std::printf("done %d\n", static_cast<int>(pros::millis() - start));
+}
+} // namespace robot
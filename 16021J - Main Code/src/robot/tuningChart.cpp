@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cmath>
+#include "robot/tuningChart.hpp"
+
+namespace robot {
+
+// chart values are integers, so they're stored in tenths to keep small errors visible
+constexpr float SCALE = 10;
+constexpr float MAX_OUTPUT = 127;
+
+static lv_coord_t toPoint(float value) {
+    return std::clamp<long>(std::lround(value * SCALE), LV_COORD_MIN, LV_COORD_MAX);
+}
+
+TuningChart::TuningChart(TuningChartSettings settings)
+    : settings(settings) {}
+
+TuningLog* TuningChart::getLog() { return &log; }
+
+void TuningChart::start() {
+    if (screen != nullptr) return;
+    screen = lv_obj_create(nullptr);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+
+    // legend, in the colors of the series
+    const bool lateral = settings.controller == TuningController::LATERAL;
+    const char* names[] = {lateral ? "Lateral error (in)" : "Angular error (deg)", "Output",
+                           lateral ? "Velocity (in/s)" : "Velocity (deg/s)"};
+    const lv_palette_t colors[] = {LV_PALETTE_RED, LV_PALETTE_BLUE, LV_PALETTE_GREEN};
+    for (int i = 0; i < 3; i++) {
+        lv_obj_t* label = lv_label_create(screen);
+        lv_obj_set_pos(label, 10 + i * 160, 5);
+        lv_obj_set_style_text_color(label, lv_palette_main(colors[i]), 0);
+        lv_label_set_text_static(label, names[i]);
+    }
+
+    chart = lv_chart_create(screen);
+    lv_obj_set_pos(chart, 10, 30);
+    lv_obj_set_size(chart, 460, 200);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_chart_set_point_count(chart, settings.points);
+    lv_chart_set_div_line_count(chart, 5, 0);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, toPoint(-settings.range), toPoint(settings.range));
+    lv_chart_set_range(chart, LV_CHART_AXIS_SECONDARY_Y, toPoint(-MAX_OUTPUT), toPoint(MAX_OUTPUT));
+    // points are only drawn as lines, which is much cheaper
+    lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);
+    errorSeries = lv_chart_add_series(chart, lv_palette_main(colors[0]), LV_CHART_AXIS_PRIMARY_Y);
+    outputSeries = lv_chart_add_series(chart, lv_palette_main(colors[1]), LV_CHART_AXIS_SECONDARY_Y);
+    velocitySeries = lv_chart_add_series(chart, lv_palette_main(colors[2]), LV_CHART_AXIS_PRIMARY_Y);
+    lv_obj_add_event_cb(
+        chart,
+        [](lv_event_t* event) {
+            TuningChart* tuningChart = static_cast<TuningChart*>(lv_event_get_user_data(event));
+            tuningChart->setPaused(!tuningChart->isPaused());
+        },
+        LV_EVENT_CLICKED, this);
+
+    pausedLabel = lv_label_create(screen);
+    lv_obj_align(pausedLabel, LV_ALIGN_TOP_RIGHT, -10, 5);
+    lv_label_set_text_static(pausedLabel, "Paused");
+    lv_obj_add_flag(pausedLabel, LV_OBJ_FLAG_HIDDEN);
+
+    lv_scr_load(screen);
+    timer = lv_timer_create([](lv_timer_t* timer) { static_cast<TuningChart*>(timer->user_data)->update(); },
+                            settings.period, this);
+}
+
+void TuningChart::setPaused(bool paused) {
+    this->paused = paused;
+    if (pausedLabel == nullptr) return;
+    if (paused) lv_obj_clear_flag(pausedLabel, LV_OBJ_FLAG_HIDDEN);
+    else lv_obj_add_flag(pausedLabel, LV_OBJ_FLAG_HIDDEN);
+}
+
+bool TuningChart::isPaused() const { return paused; }
+
+void TuningChart::update() {
+    const bool lateral = settings.controller == TuningController::LATERAL;
+    TuningSample sample;
+    // always empty the log, so it doesn't fill up while paused
+    while (log.pop(sample)) {
+        if (paused) {
+            count = 0;
+            errorSum = outputSum = velocitySum = 0;
+            continue;
+        }
+        errorSum += lateral ? sample.lateralError : sample.angularError;
+        outputSum += lateral ? sample.lateralOutput : sample.angularOutput;
+        velocitySum += lateral ? sample.velocity : sample.angularVelocity;
+        if (++count < settings.decimation) continue;
+        // in circular mode this overwrites the oldest point, and only invalidates the area around it
+        lv_chart_set_next_value(chart, errorSeries, toPoint(errorSum / count));
+        lv_chart_set_next_value(chart, outputSeries, toPoint(outputSum / count));
+        lv_chart_set_next_value(chart, velocitySeries, toPoint(velocitySum / count));
+        count = 0;
+        errorSum = outputSum = velocitySum = 0;
+    }
+}
+} // namespace robot
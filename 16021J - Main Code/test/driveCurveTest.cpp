@@ -0,0 +1,41 @@
+// TableDriveCurve has to give exactly the outputs of lemlib::ExpoDriveCurve, and be faster than it
+
+#include <chrono>
+#include "robot/driveCurve.hpp"
+#include "test.hpp"
+
+static void checkExact(float deadband, float minOutput, float curve) {
+    lemlib::ExpoDriveCurve expo(deadband, minOutput, curve);
+    robot::TableDriveCurve table(deadband, minOutput, curve);
+    for (int input = -127; input <= 127; input++) CHECK(table.curve(input) == expo.curve(input));
+    // inputs between whole numbers round to the nearest one, inputs out of range clamp
+    CHECK(table.curve(63.4f) == expo.curve(63));
+    CHECK(table.curve(-63.6f) == expo.curve(-64));
+    CHECK(table.curve(200) == expo.curve(127));
+    CHECK(table.curve(-200) == expo.curve(-127));
+    CHECK(table.curve(NAN) == expo.curve(-127));
+}
+
+template <typename Curve> static double nanosecondsPerCall(Curve& curve) {
+    constexpr int ROUNDS = 2000;
+    volatile float sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++)
+        for (int input = -127; input <= 127; input++) sink = sink + curve.curve(input);
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (ROUNDS * 255.0);
+}
+
+int main() {
+    checkExact(0, 0, 1);
+    checkExact(3, 10, 1.019);
+    checkExact(5, 12, 1.132);
+    checkExact(10, 0, 1.05);
+
+    lemlib::ExpoDriveCurve expo(3, 10, 1.019);
+    robot::TableDriveCurve table(3, 10, 1.019);
+    // only printed, timing on a shared computer is too noisy to fail on
+    std::printf("ExpoDriveCurve %.1f ns per call, TableDriveCurve %.1f ns per call\n", nanosecondsPerCall(expo),
+                nanosecondsPerCall(table));
+    return test::finish();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include "pros/distance.hpp"
+#include "pros/error.h"
+#include "pros/gps.hpp"
+#include "lemlib/pose.hpp"
+
+/**
+ * @brief Controls for the fakes the host tests link against
+ */
+namespace fake {
+/** when set, pros::millis and pros::micros return this instead of the time since the test started, in ms */
+extern std::optional<std::uint32_t> time;
+/** when false, tasks are never started, so the test can call update() itself. True by default */
+extern bool runTasks;
+
+/**
+ * @brief What a pros::Imu on a port reports
+ */
+struct Imu {
+        /** in degrees, clockwise is positive */
+        double rotation = 0;
+        /** the z gyro rate, in degrees per second */
+        double rate = 0;
+        bool calibrating = false;
+        /** set by set_data_rate, in ms */
+        std::uint32_t dataRate = 10;
+};
+
+/** the IMUs, by port */
+extern std::array<Imu, 22> imus;
+
+/** the pose returned by robot::getPose, with theta in radians. robot::correctPose adds to it */
+extern lemlib::Pose pose;
+/** the speed returned by robot::getSpeed, with theta in radians */
+extern lemlib::Pose speed;
+
+/**
+ * @brief A GPS sensor that reports whatever the test sets
+ */
+class Gps : public pros::Gps {
+    public:
+        Gps()
+            : pros::Gps(1) {}
+
+        double get_error() const override { return error; }
+
+        pros::gps_status_s_t get_position_and_orientation() const override { return status; }
+
+        /** the error reported by the sensor, in meters */
+        double error = PROS_ERR_F;
+        /** position in meters and yaw in degrees. Yaw is used as the LemLib heading */
+        pros::gps_status_s_t status {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+};
+
+/**
+ * @brief A distance sensor that reports whatever the test sets
+ */
+class Distance : public pros::Distance {
+    public:
+        Distance()
+            : pros::Distance(2) {}
+
+        std::int32_t get() override { return distance; }
+
+        std::int32_t get_distance() override { return distance; }
+
+        std::int32_t get_confidence() override { return confidence; }
+
+        /** the reading, in mm */
+        std::int32_t distance = PROS_ERR;
+        /** the confidence of the reading, from 0 to 63 */
+        std::int32_t confidence = 63;
+};
+} // namespace fake
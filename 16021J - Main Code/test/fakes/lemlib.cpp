@@ -0,0 +1,77 @@
+// The LemLib v0.5 functions the tested code calls. LemLib is only linked into the robot program as a prebuilt
+// library, so the tests carry copies of them
+
+#include <cmath>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/util.hpp"
+
+lemlib::ExpoDriveCurve::ExpoDriveCurve(float deadband, float minOutput, float curve)
+    : deadband(deadband),
+      minOutput(minOutput),
+      curveGain(curve) {}
+
+float lemlib::ExpoDriveCurve::curve(float input) {
+    // return 0 if input is within deadzone
+    if (std::fabs(input) <= deadband) return 0;
+    // g is the output of g(x) as defined in the Desmos graph
+    const float g = std::fabs(input) - deadband;
+    // g127 is the output of g(127) as defined in the Desmos graph
+    const float g127 = 127 - deadband;
+    // i is the output of i(x) as defined in the Desmos graph
+    const float i = std::pow(curveGain, g - 127) * g * lemlib::sgn(input);
+    // i127 is the output of i(127) as defined in the Desmos graph
+    const float i127 = std::pow(curveGain, g127 - 127) * g127;
+    return (127.0 - minOutput) / (127) * i * 127 / i127 + minOutput * lemlib::sgn(input);
+}
+
+lemlib::Pose::Pose(float x, float y, float theta)
+    : x(x),
+      y(y),
+      theta(theta) {}
+
+lemlib::Pose lemlib::Pose::operator+(const lemlib::Pose& other) const {
+    return lemlib::Pose(this->x + other.x, this->y + other.y, this->theta);
+}
+
+lemlib::Pose lemlib::Pose::operator-(const lemlib::Pose& other) const {
+    return lemlib::Pose(this->x - other.x, this->y - other.y, this->theta);
+}
+
+float lemlib::Pose::operator*(const lemlib::Pose& other) const { return this->x * other.x + this->y * other.y; }
+
+lemlib::Pose lemlib::Pose::operator*(const float& other) const {
+    return lemlib::Pose(this->x * other, this->y * other, this->theta);
+}
+
+lemlib::Pose lemlib::Pose::operator/(const float& other) const {
+    return lemlib::Pose(this->x / other, this->y / other, this->theta);
+}
+
+lemlib::Pose lemlib::Pose::lerp(lemlib::Pose other, float t) const {
+    return lemlib::Pose(this->x + (other.x - this->x) * t, this->y + (other.y - this->y) * t, this->theta);
+}
+
+float lemlib::Pose::distance(lemlib::Pose other) const { return std::hypot(this->x - other.x, this->y - other.y); }
+
+float lemlib::Pose::angle(lemlib::Pose other) const { return std::atan2(other.y - this->y, other.x - this->x); }
+
+lemlib::Pose lemlib::Pose::rotate(float angle) const {
+    return lemlib::Pose(this->x * std::cos(angle) - this->y * std::sin(angle),
+                        this->x * std::sin(angle) + this->y * std::cos(angle), this->theta);
+}
+
+float lemlib::angleError(float target, float position, bool radians, lemlib::AngularDirection direction) {
+    // bound angles from 0 to 2pi or 0 to 360
+    const float max = radians ? 2 * M_PI : 360;
+    target = std::fmod(std::fmod(target, max) + max, max);
+    position = std::fmod(std::fmod(position, max) + max, max);
+    const float rawError = target - position;
+    switch (direction) {
+        case lemlib::AngularDirection::CW_CLOCKWISE: // turn clockwise
+            return rawError < 0 ? rawError + max : rawError; // add max if sign does not match
+        case lemlib::AngularDirection::CCW_COUNTERCLOCKWISE: // turn counter-clockwise
+            return rawError > 0 ? rawError - max : rawError; // subtract max if sign does not match
+        default: // choose the shortest path
+            return std::remainder(rawError, max);
+    }
+}
@@ -0,0 +1,217 @@
+// The parts of the PROS kernel the tested code calls, on top of std::thread and std::chrono. Sensors report
+// PROS_ERR unless a test overrides them, see fakes.hpp
+
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include "pros/distance.hpp"
+#include "pros/error.h"
+#include "pros/gps.hpp"
+#include "pros/imu.hpp"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include "fakes/fakes.hpp"
+
+static const auto START = std::chrono::steady_clock::now();
+
+namespace fake {
+std::optional<std::uint32_t> time;
+bool runTasks = true;
+std::array<Imu, 22> imus;
+} // namespace fake
+
+namespace pros {
+namespace c {
+std::uint32_t millis() {
+    if (fake::time) return *fake::time;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+std::uint64_t micros() {
+    if (fake::time) return *fake::time * 1000ull;
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+void delay(const std::uint32_t milliseconds) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+void task_delay(const std::uint32_t milliseconds) { delay(milliseconds); }
+} // namespace c
+
+namespace usd {
+std::int32_t is_installed() { return 1; }
+} // namespace usd
+
+Mutex::Mutex()
+    : mutex(new std::mutex, [](void* mutex) { delete static_cast<std::mutex*>(mutex); }) {}
+
+bool Mutex::take() {
+    static_cast<std::mutex*>(mutex.get())->lock();
+    return true;
+}
+
+bool Mutex::take(std::uint32_t timeout) {
+    if (timeout == 0) return static_cast<std::mutex*>(mutex.get())->try_lock();
+    return take();
+}
+
+bool Mutex::give() {
+    static_cast<std::mutex*>(mutex.get())->unlock();
+    return true;
+}
+
+void Mutex::lock() { take(); }
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+// tasks are detached threads that run until the test exits
+Task::Task(task_fn_t function, void* parameters, std::uint32_t, std::uint16_t, const char*) {
+    if (fake::runTasks) std::thread(function, parameters).detach();
+}
+
+void Task::delay(const std::uint32_t milliseconds) { c::delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    *prev_time += delta;
+    const std::int64_t remaining = static_cast<std::int64_t>(*prev_time) - c::millis();
+    if (remaining > 0) c::delay(remaining);
+}
+
+Device::Device(const std::uint8_t port)
+    : _port(port) {}
+
+std::uint8_t Device::get_port() const { return _port; }
+
+bool Device::is_installed() { return true; }
+
+Distance::Distance(const std::uint8_t port)
+    : Device(port, DeviceType::distance) {}
+
+std::int32_t Distance::get() { return PROS_ERR; }
+
+std::int32_t Distance::get_distance() { return PROS_ERR; }
+
+std::int32_t Distance::get_confidence() { return PROS_ERR; }
+
+std::int32_t Distance::get_object_size() { return PROS_ERR; }
+
+double Distance::get_object_velocity() { return PROS_ERR_F; }
+
+std::int32_t Gps::initialize_full(double, double, double, double, double) const { return PROS_ERR; }
+
+std::int32_t Gps::set_offset(double, double) const { return PROS_ERR; }
+
+gps_position_s_t Gps::get_offset() const { return {PROS_ERR_F, PROS_ERR_F}; }
+
+std::int32_t Gps::set_position(double, double, double) const { return PROS_ERR; }
+
+std::int32_t Gps::set_data_rate(std::uint32_t) const { return PROS_ERR; }
+
+double Gps::get_error() const { return PROS_ERR_F; }
+
+gps_status_s_t Gps::get_position_and_orientation() const {
+    return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+}
+
+gps_position_s_t Gps::get_position() const { return {PROS_ERR_F, PROS_ERR_F}; }
+
+double Gps::get_position_x() const { return PROS_ERR_F; }
+
+double Gps::get_position_y() const { return PROS_ERR_F; }
+
+gps_orientation_s_t Gps::get_orientation() const { return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F}; }
+
+double Gps::get_pitch() const { return PROS_ERR_F; }
+
+double Gps::get_roll() const { return PROS_ERR_F; }
+
+double Gps::get_yaw() const { return PROS_ERR_F; }
+
+double Gps::get_heading() const { return PROS_ERR_F; }
+
+double Gps::get_heading_raw() const { return PROS_ERR_F; }
+
+gps_gyro_s_t Gps::get_gyro_rate() const { return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F}; }
+
+double Gps::get_gyro_rate_x() const { return PROS_ERR_F; }
+
+double Gps::get_gyro_rate_y() const { return PROS_ERR_F; }
+
+double Gps::get_gyro_rate_z() const { return PROS_ERR_F; }
+
+gps_accel_s_t Gps::get_accel() const { return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F}; }
+
+double Gps::get_accel_x() const { return PROS_ERR_F; }
+
+double Gps::get_accel_y() const { return PROS_ERR_F; }
+
+double Gps::get_accel_z() const { return PROS_ERR_F; }
+std::int32_t Imu::reset(bool) const {
+    fake::imus[_port].rotation = 0;
+    return 1;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t rate) const {
+    fake::imus[_port].dataRate = rate;
+    return 1;
+}
+
+double Imu::get_rotation() const { return fake::imus[_port].rotation; }
+
+double Imu::get_heading() const { return std::fmod(std::fmod(get_rotation(), 360) + 360, 360); }
+
+quaternion_s_t Imu::get_quaternion() const { return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F}; }
+
+euler_s_t Imu::get_euler() const { return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F}; }
+
+double Imu::get_pitch() const { return PROS_ERR_F; }
+
+double Imu::get_roll() const { return PROS_ERR_F; }
+
+double Imu::get_yaw() const { return PROS_ERR_F; }
+
+imu_gyro_s_t Imu::get_gyro_rate() const { return {0, 0, fake::imus[_port].rate}; }
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return PROS_ERR; }
+
+std::int32_t Imu::tare_yaw() const { return PROS_ERR; }
+
+std::int32_t Imu::tare_roll() const { return PROS_ERR; }
+
+std::int32_t Imu::tare() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_euler() const { return PROS_ERR; }
+
+std::int32_t Imu::set_heading(const double target) const { return set_rotation(target); }
+
+std::int32_t Imu::set_rotation(const double target) const {
+    fake::imus[_port].rotation = target;
+    return 1;
+}
+
+std::int32_t Imu::set_yaw(const double) const { return PROS_ERR; }
+
+std::int32_t Imu::set_pitch(const double) const { return PROS_ERR; }
+
+std::int32_t Imu::set_roll(const double) const { return PROS_ERR; }
+
+std::int32_t Imu::set_euler(const euler_s_t) const { return PROS_ERR; }
+
+imu_accel_s_t Imu::get_accel() const { return {0, 0, 1}; }
+
+ImuStatus Imu::get_status() const {
+    return fake::imus[_port].calibrating ? ImuStatus::calibrating : ImuStatus::ready;
+}
+
+bool Imu::is_calibrating() const { return fake::imus[_port].calibrating; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return E_IMU_Z_UP; }
+} // namespace pros
@@ -0,0 +1,31 @@
+// The parts of src/robot that read real sensors, replaced with values the tests set, see fakes.hpp
+
+#include "lemlib/util.hpp"
+#include "robot/odom.hpp"
+#include "robot/slipDetector.hpp"
+#include "fakes/fakes.hpp"
+
+namespace fake {
+lemlib::Pose pose = {0, 0, 0};
+lemlib::Pose speed = {0, 0, 0};
+} // namespace fake
+
+lemlib::Pose robot::getPose(bool radians, bool standardPos) {
+    lemlib::Pose pose = fake::pose;
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = lemlib::radToDeg(pose.theta);
+    return pose;
+}
+
+void robot::correctPose(lemlib::Pose correction) {
+    fake::pose = {fake::pose.x + correction.x, fake::pose.y + correction.y, fake::pose.theta + correction.theta};
+}
+
+lemlib::Pose robot::getSpeed(bool radians) {
+    lemlib::Pose speed = fake::speed;
+    if (!radians) speed.theta = lemlib::radToDeg(speed.theta);
+    return speed;
+}
+
+// no slip detector in the tests
+float robot::SlipDetector::getOdomNoiseScale() const { return 1; }
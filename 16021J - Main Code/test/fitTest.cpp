@@ -0,0 +1,54 @@
+// fitTrackingWheel has to recover the offset and diameter of a tracking wheel from noisy samples taken while the
+// robot spins in place, the way Chassis::calibrateTrackingWheels takes them
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "robot/fit.hpp"
+#include "test.hpp"
+
+int main() {
+    std::mt19937 random(7);
+    std::normal_distribution<float> noise(0, 0.02);
+
+    // the wheel was constructed with a diameter 3% too small, so it reports 3% too little distance
+    constexpr float DIAMETER_SCALE = 1.03;
+    constexpr float PUSH_DISTANCE = 48;
+    for (const float offset : {-5.5f, 0.0f, 2.25f, 7.0f}) {
+        // 5 spins of 4 quarter turns, alternating directions, with the first sample at a random heading
+        std::vector<float> angles;
+        std::vector<float> distances;
+        float angle = 0.3;
+        for (int spin = 0; spin < 5; spin++) {
+            for (int quarter = 0; quarter <= 4; quarter++) {
+                if (spin > 0 && quarter == 0) continue;
+                if (quarter > 0) angle += (spin % 2 == 0 ? 1 : -1) * M_PI / 2;
+                angles.push_back(angle + noise(random) * 0.01f);
+                distances.push_back((-offset * angle + noise(random)) / DIAMETER_SCALE);
+            }
+        }
+
+        const robot::TrackingWheelFit fit = robot::fitTrackingWheel(angles.data(), distances.data(), angles.size(),
+                                                                    PUSH_DISTANCE, PUSH_DISTANCE / DIAMETER_SCALE);
+        CHECK(fit.valid);
+        CHECK_NEAR(fit.offset, offset, 0.02);
+        CHECK_NEAR(fit.diameterScale, DIAMETER_SCALE, 1e-4);
+        if (offset != 0) CHECK(fit.rSquared > 0.999);
+
+        // without a push the offset is in the units of the wrong diameter
+        const robot::TrackingWheelFit unscaled =
+            robot::fitTrackingWheel(angles.data(), distances.data(), angles.size());
+        CHECK(unscaled.diameterScale == 1);
+        CHECK_NEAR(unscaled.offset, offset / DIAMETER_SCALE, 0.02);
+
+        // a push that barely moved the wheel is ignored
+        CHECK(robot::fitTrackingWheel(angles.data(), distances.data(), angles.size(), PUSH_DISTANCE, 0.5)
+                  .diameterScale == 1);
+    }
+
+    // one sample isn't enough
+    const float angle = 0;
+    const float distance = 0;
+    CHECK(!robot::fitTrackingWheel(&angle, &distance, 1).valid);
+    return test::finish();
+}
@@ -0,0 +1,57 @@
+// FusedImu has to learn the drift of its IMUs while the robot is still, keep every turn made while driving, even
+// one slower than the stationary rate, and ignore an IMU that glitches
+
+#include <random>
+#include "robot/fusedImu.hpp"
+#include "fakes/fakes.hpp"
+#include "test.hpp"
+
+constexpr int DT = 10;
+constexpr std::uint8_t PORTS[3] = {1, 2, 3};
+constexpr double BIASES[3] = {0.05, -0.03, 0.04};
+
+int main() {
+    fake::time = 0;
+    fake::runTasks = false;
+    std::mt19937 random(4);
+    std::normal_distribution<double> noise(0, 0.02);
+
+    robot::FusedImu imu({PORTS[0], PORTS[1], PORTS[2]});
+    CHECK(imu.reset() == 1);
+    double truth = 0;
+    bool heldWhileDriving = false;
+    for (int time = DT; time <= 60000; time += DT) {
+        // still, straight, a slow arc, a turn in place, and still again, in degrees per second and inches per second
+        double rate = 0;
+        float speed = 0;
+        if (time > 10000 && time <= 25000) speed = 40;
+        else if (time > 25000 && time <= 40000) {
+            rate = 0.3;
+            speed = 20;
+        } else if (time > 40000 && time <= 45000) rate = 90;
+        fake::speed = {0, speed, 0};
+
+        truth += rate * DT / 1000;
+        for (int i = 0; i < 3; i++) {
+            double measured = rate + BIASES[i] + noise(random);
+            // the third IMU glitches for 5 seconds
+            if (i == 2 && time > 30000 && time <= 35000) measured += 20;
+            fake::imus[PORTS[i]].rate = measured;
+            fake::imus[PORTS[i]].rotation += measured * DT / 1000;
+        }
+        *fake::time = time;
+        imu.update();
+        if (speed > 0 && imu.isStationary()) heldWhileDriving = true;
+    }
+
+    const double fusedError = std::fabs(imu.get_rotation() - truth);
+    const double rawError = std::fabs(fake::imus[PORTS[0]].rotation - truth);
+    std::printf("after 60s: fused heading error %.3f deg, single IMU error %.3f deg\n", fusedError, rawError);
+    CHECK(imu.getReadyCount() == 3);
+    CHECK(!heldWhileDriving);
+    CHECK(fusedError < 0.3);
+    CHECK(fusedError < rawError / 5);
+    for (int i = 0; i < 3; i++) CHECK_NEAR(imu.getBias(i), BIASES[i], 0.01);
+    CHECK(imu.isStationary());
+    return test::finish();
+}
@@ -0,0 +1,123 @@
+// Odometry every 5ms has to track a winding drive better than every 10ms, but only when the IMU reports every 5ms
+// too. With the IMU left at 10ms, every other update moves the robot with an old heading
+
+#include "lemlib/util.hpp"
+#include "robot/fusedImu.hpp"
+#include "fakes/fakes.hpp"
+#include "test.hpp"
+
+constexpr std::uint8_t PORT = 1;
+// where the tracking wheels are, in inches, as passed to lemlib::TrackingWheel
+constexpr float VERTICAL_OFFSET = -1;
+constexpr float HORIZONTAL_OFFSET = -5;
+
+struct Result {
+        double rmsError;
+        double finalError;
+};
+
+// the arc integration of lemlib::update, for one vertical and one horizontal tracking wheel and an IMU
+static void odomStep(lemlib::Pose& pose, float deltaVertical, float deltaHorizontal, float heading) {
+    const float deltaHeading = heading - pose.theta;
+    const float avgHeading = pose.theta + deltaHeading / 2;
+    float localX = deltaHorizontal;
+    float localY = deltaVertical;
+    if (deltaHeading != 0) {
+        localX = 2 * std::sin(deltaHeading / 2) * (deltaHorizontal / deltaHeading + HORIZONTAL_OFFSET);
+        localY = 2 * std::sin(deltaHeading / 2) * (deltaVertical / deltaHeading + VERTICAL_OFFSET);
+    }
+    pose.x += localY * std::sin(avgHeading) - localX * std::cos(avgHeading);
+    pose.y += localY * std::cos(avgHeading) + localX * std::sin(avgHeading);
+    pose.theta = heading;
+}
+
+// drive 20 seconds of curves, simulated every millisecond. Odometry runs phase ms after the IMU reports
+static Result drive(int odomPeriod, int imuPeriod, int phase) {
+    fake::imus[PORT] = {};
+    *fake::time = 0;
+    robot::FusedImu imu({PORT});
+    imu.reset();
+    imu.set_data_rate(imuPeriod);
+
+    double x = 0;
+    double y = 0;
+    double theta = 0;
+    double vertical = 0;
+    double horizontal = 0;
+    float prevVertical = 0;
+    float prevHorizontal = 0;
+    lemlib::Pose odom = {0, 0, 0};
+    bool started = false;
+    double squaredError = 0;
+    int samples = 0;
+    for (int time = 1; time <= 21000; time++) {
+        // still for a second while the IMU calibrates, then turning back and forth at up to 180 deg/s, between 30
+        // and 60 in/s
+        const double seconds = (time - 1000) / 1000.0;
+        const double rate = time > 1000 ? lemlib::degToRad(180) * std::sin(2 * M_PI * seconds / 3) : 0;
+        const double speed = time > 1000 ? 45 + 15 * std::sin(2 * M_PI * seconds / 5) : 0;
+        const double dt = 0.001;
+        x += speed * dt * std::sin(theta + rate * dt / 2);
+        y += speed * dt * std::cos(theta + rate * dt / 2);
+        theta += rate * dt;
+        vertical += speed * dt - VERTICAL_OFFSET * rate * dt;
+        horizontal += -HORIZONTAL_OFFSET * rate * dt;
+        fake::speed = {0, static_cast<float>(speed), 0};
+
+        // the IMU reports at its data rate, and FusedImu fuses each report
+        *fake::time = time;
+        if (time % imuPeriod == 0) {
+            fake::imus[PORT].rotation = lemlib::radToDeg(theta);
+            fake::imus[PORT].rate = lemlib::radToDeg(rate);
+            imu.update();
+        }
+        if (time % odomPeriod != phase % odomPeriod) continue;
+        // start odometry where the robot is once the IMU is calibrated
+        if (time < 1000) continue;
+        if (!started) {
+            started = true;
+            odom = {static_cast<float>(x), static_cast<float>(y), lemlib::degToRad(imu.get_rotation())};
+            prevVertical = vertical;
+            prevHorizontal = horizontal;
+            continue;
+        }
+        odomStep(odom, vertical - prevVertical, horizontal - prevHorizontal, lemlib::degToRad(imu.get_rotation()));
+        prevVertical = vertical;
+        prevHorizontal = horizontal;
+        squaredError += std::pow(odom.x - x, 2) + std::pow(odom.y - y, 2);
+        samples++;
+    }
+    return {std::sqrt(squaredError / samples), std::hypot(odom.x - x, odom.y - y)};
+}
+
+// the odometry and IMU clocks aren't synchronized, so average over every phase between them
+static Result average(int odomPeriod, int imuPeriod) {
+    Result sum = {0, 0};
+    for (int phase = 0; phase < imuPeriod; phase++) {
+        const Result result = drive(odomPeriod, imuPeriod, phase);
+        sum.rmsError += result.rmsError / imuPeriod;
+        sum.finalError += result.finalError / imuPeriod;
+    }
+    return sum;
+}
+
+int main() {
+    fake::time = 0;
+    fake::runTasks = false;
+
+    const Result slow = average(10, 10);
+    const Result fast = average(5, 5);
+    const Result staleImu = average(5, 10);
+    std::printf("odometry 10ms, IMU 10ms: RMS error %.3f in, final error %.3f in\n", slow.rmsError, slow.finalError);
+    std::printf("odometry 5ms, IMU 5ms: RMS error %.3f in, final error %.3f in\n", fast.rmsError, fast.finalError);
+    std::printf("odometry 5ms, IMU 10ms: RMS error %.3f in, final error %.3f in\n", staleImu.rmsError,
+                staleImu.finalError);
+    CHECK(fast.rmsError < slow.rmsError);
+    CHECK(fast.rmsError < staleImu.rmsError);
+
+    // the rate reaches every IMU, rounded down to a multiple of 5ms
+    robot::FusedImu imu({2, 3});
+    CHECK(imu.set_data_rate(7) == 1);
+    CHECK(fake::imus[2].dataRate == 5 && fake::imus[3].dataRate == 5);
+    return test::finish();
+}
@@ -0,0 +1,114 @@
+// ParamStore has to round trip values through its files, fall back to the older file when the newer one is
+// corrupt, and ignore files from another schema version
+
+#include <cstdio>
+#include "robot/params.hpp"
+#include "test.hpp"
+
+// saved in the directory ctest runs the test in
+constexpr const char* PATH = "paramsTest";
+
+static int changes = 0;
+
+static void changed() { changes++; }
+
+struct Robot {
+        Robot(std::uint16_t schemaVersion = 1)
+            : params(schemaVersion, PATH) {}
+
+        robot::ParamStore params;
+        robot::Param<int> speed {params, "speed", 127, changed};
+        robot::Param<float> kP {params, "kP", 10.5f};
+        robot::Param<bool> reversed {params, "reversed", false};
+};
+
+static void corrupt(int slot) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s.%d", PATH, slot);
+    FILE* file = std::fopen(name, "r+b");
+    CHECK(file != nullptr);
+    if (file == nullptr) return;
+    std::fseek(file, 14, SEEK_SET);
+    std::fputc(0x5A, file);
+    std::fclose(file);
+}
+
+int main() {
+    std::remove("paramsTest.0");
+    std::remove("paramsTest.1");
+
+    {
+        Robot robot;
+        CHECK(!robot.params.load());
+        CHECK(robot.speed == 127);
+        CHECK(robot.kP == 10.5f);
+        CHECK(!robot.reversed);
+
+        CHECK(robot.params.set("speed", "90"));
+        CHECK(robot.params.set("kP", "2.25"));
+        CHECK(robot.params.set("reversed", "1"));
+        CHECK(!robot.params.set("speed", "fast"));
+        CHECK(!robot.params.set("missing", "1"));
+        CHECK(robot.speed == 90);
+        CHECK(changes == 1);
+        CHECK(robot.params.save());
+
+        CHECK(robot.params.handle("param set speed 60"));
+        CHECK(robot.params.handle("param save"));
+        CHECK(!robot.params.handle("tune lateral"));
+    }
+
+    {
+        // the newest save is loaded
+        Robot robot;
+        changes = 0;
+        CHECK(robot.params.load());
+        CHECK(robot.speed == 60);
+        CHECK(robot.kP == 2.25f);
+        CHECK(robot.reversed);
+        CHECK(changes == 1);
+
+        robot.params.reset();
+        CHECK(robot.speed == 127);
+        CHECK(robot.kP == 10.5f);
+    }
+
+    {
+        // the second save went to slot 1. With it corrupt, the first save is loaded
+        corrupt(1);
+        Robot robot;
+        CHECK(robot.params.load());
+        CHECK(robot.speed == 90);
+        // and the next save replaces the corrupt file, not the good one
+        CHECK(robot.params.set("speed", "30"));
+        CHECK(robot.params.save());
+        corrupt(0);
+    }
+
+    {
+        Robot robot;
+        CHECK(robot.params.load());
+        CHECK(robot.speed == 30);
+    }
+
+    {
+        // another schema version keeps the defaults
+        Robot robot(2);
+        CHECK(!robot.params.load());
+        CHECK(robot.speed == 127);
+    }
+
+    {
+        // a parameter that changed type keeps its default, the others still load
+        robot::ParamStore params(1, PATH);
+        robot::Param<float> speed {params, "speed", 127.0f};
+        robot::Param<float> kP {params, "kP", 10.5f};
+        CHECK(params.load());
+        CHECK(speed == 127.0f);
+        CHECK(kP == 2.25f);
+    }
+
+    std::remove("paramsTest.0");
+    std::remove("paramsTest.1");
+    return test::finish();
+}
@@ -0,0 +1,69 @@
+// ParticleFilter has to find the pose from wall sensors when odometry starts several inches off, keep it while
+// driving, and report how many particles it processes per second
+
+#include <random>
+#include "robot/fieldMap.hpp"
+#include "robot/particleFilter.hpp"
+#include "fakes/fakes.hpp"
+#include "test.hpp"
+
+constexpr float ANGLES[4] = {0, 90, 180, -90};
+
+// distance in mm from a sensor at the center of the robot to the wall it faces, with the robot facing +y
+static std::int32_t wallDistance(const lemlib::Pose& truth, float angle) {
+    float inches = 0;
+    if (angle == 0) inches = robot::FIELD_HALF_WIDTH - truth.y;
+    else if (angle == 90) inches = robot::FIELD_HALF_WIDTH - truth.x;
+    else if (angle == 180) inches = robot::FIELD_HALF_WIDTH + truth.y;
+    else inches = robot::FIELD_HALF_WIDTH + truth.x;
+    return std::lround(inches * 25.4f);
+}
+
+int main() {
+    std::mt19937 random(3);
+    std::normal_distribution<float> noise(0, 5);
+
+    lemlib::Pose truth = {5, -5, 0};
+    fake::pose = {9, -8, 0};
+    robot::ParticleFilter filter;
+    fake::Distance sensors[4];
+    for (int i = 0; i < 4; i++) CHECK(filter.addWallSensor({&sensors[i], 0, 0, ANGLES[i]}));
+    CHECK(!filter.addWallSensor({&sensors[0], 0, 0, 0}));
+    filter.reset(6, 3);
+
+    const auto read = [&] {
+        for (int i = 0; i < 4; i++) sensors[i].distance = wallDistance(truth, ANGLES[i]) + noise(random);
+    };
+
+    // standing still, 5 seconds of updates at the default 50ms period
+    for (int tick = 0; tick < 100; tick++) {
+        read();
+        filter.update();
+    }
+    std::printf("standing: error %.2f in, odometry error %.2f in\n", filter.getPose(true).distance(truth),
+                fake::pose.distance(truth));
+    CHECK(filter.getPose(true).distance(truth) < 1);
+    CHECK(fake::pose.distance(truth) < 1);
+
+    // drive 60 inches forward at 20 in/s, with wheels that slip and read 5% long. odom is the pose from the wheels
+    // alone, fake::pose also has the filter's corrections. The back sensor goes out of range
+    lemlib::Pose odom = fake::pose;
+    for (int tick = 0; tick < 60; tick++) {
+        truth.y += 1;
+        odom.y += 1.05f;
+        fake::pose.y += 1.05f;
+        read();
+        filter.update();
+    }
+    std::printf("driving: error %.2f in, corrected odometry error %.2f in, dead reckoning error %.2f in\n",
+                filter.getPose(true).distance(truth), fake::pose.distance(truth), odom.distance(truth));
+    CHECK(odom.distance(truth) > 1.5);
+    CHECK(filter.getPose(true).distance(truth) < 1.5);
+    CHECK(fake::pose.distance(truth) < 1.5);
+    CHECK(filter.getPose(true).distance(truth) < odom.distance(truth) / 2);
+
+    // only printed, the V5 brain is many times slower than the computer running the tests
+    std::printf("%.0f particles per second\n", filter.getParticlesPerSecond());
+    CHECK(filter.getParticlesPerSecond() > 0);
+    return test::finish();
+}
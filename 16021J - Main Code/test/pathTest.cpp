@@ -0,0 +1,50 @@
+// Path has to parse path.jerryio assets, and its precalculated durations have to match driving it segment by
+// segment
+
+#include <cstring>
+#include <string>
+#include "robot/path.hpp"
+#include "test.hpp"
+
+// time left from a distance along the path, one segment at a time
+static float bruteForceDuration(const robot::Path& path, float maxVelocity, float from) {
+    float time = 0;
+    for (size_t i = 0; i + 1 < path.size() && path[i + 1].distance <= path.length(); i++) {
+        const float start = std::max(path[i].distance, from);
+        if (path[i + 1].distance <= start) continue;
+        const float speed = std::max((path[i].speed + path[i + 1].speed) / 2, 1.0f) / 127 * maxVelocity;
+        time += (path[i + 1].distance - start) / speed;
+    }
+    return time;
+}
+
+int main() {
+    // 10 inch steps along a curve, stopped at the start and padded with stopped points at the end
+    std::string text;
+    for (int i = 0; i <= 12; i++) {
+        const float speed = i == 0 || i >= 10 ? 0 : 40 + i * 8;
+        text += std::to_string(i * 10.0) + ", " + std::to_string(i * i * 0.5) + ", " + std::to_string(speed) + "\n";
+    }
+    text += "endData\n#PATH.JERRYIO-DATA {}\n";
+    std::string buffer = text;
+    const asset file = {reinterpret_cast<std::uint8_t*>(buffer.data()), buffer.size()};
+    const robot::Path path(file);
+
+    CHECK(path.size() == 13);
+    CHECK(path[12].x == 120);
+    CHECK(path.length() == path[10].distance);
+    CHECK(path[0].time == 0);
+
+    constexpr float MAX_VELOCITY = 60;
+    for (float from = 0; from < path.length(); from += 3.7f) {
+        const size_t hint = path.indexAt(from);
+        CHECK_NEAR(path.duration(MAX_VELOCITY, from, hint), bruteForceDuration(path, MAX_VELOCITY, from), 1e-3);
+        // the hint only speeds up the search
+        CHECK_NEAR(path.duration(MAX_VELOCITY, from), path.duration(MAX_VELOCITY, from, hint), 1e-5);
+    }
+    CHECK_NEAR(path.duration(MAX_VELOCITY / 2), 2 * path.duration(MAX_VELOCITY), 1e-3);
+    CHECK(path.duration(MAX_VELOCITY, path.length()) == 0);
+    CHECK(path.duration(MAX_VELOCITY, path.length() + 5) == 0);
+    CHECK(robot::Path(std::vector<robot::PathPoint> {}).duration(MAX_VELOCITY) == 0);
+    return test::finish();
+}
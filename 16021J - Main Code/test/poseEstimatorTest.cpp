@@ -0,0 +1,116 @@
+// PoseEstimator has to keep the pose close to the truth when odometry drifts, using a noisy GPS or wall sensors,
+// and ignore readings that are far off
+
+#include <random>
+#include "lemlib/util.hpp"
+#include "robot/poseEstimator.hpp"
+#include "fakes/fakes.hpp"
+#include "test.hpp"
+
+constexpr float M_TO_IN = 39.3701;
+constexpr float DT = 0.01;
+
+// move a pose forward and turn it, in LemLib's convention
+static void step(lemlib::Pose& pose, float forward, float turn) {
+    const float heading = pose.theta + turn / 2;
+    pose.x += forward * std::sin(heading);
+    pose.y += forward * std::cos(heading);
+    pose.theta += turn;
+}
+
+// drive in circles for a minute with odometry that drifts, correcting it with a GPS
+static void gps() {
+    std::mt19937 random(1);
+    std::normal_distribution<float> positionNoise(0, 0.5f / M_TO_IN);
+    std::normal_distribution<float> headingNoise(0, 1);
+
+    fake::Gps sensor;
+    sensor.error = 0.015;
+    lemlib::Pose truth = {-50, 0, 0};
+    lemlib::Pose odomOnly = truth;
+    fake::pose = truth;
+    robot::PoseEstimator estimator(&sensor);
+    estimator.reset(1, 1);
+
+    double odomError = 0;
+    double positionError = 0;
+    double headingError = 0;
+    int samples = 0;
+    for (int tick = 0; tick < 6000; tick++) {
+        // 30 in/s on a circle with a radius of 50 inches
+        const float forward = 30 * DT;
+        const float turn = 0.6f * DT;
+        step(truth, forward, turn);
+        // the wheels read 2% long and the IMU 0.5% high, within the default odomDrift and headingDrift
+        step(odomOnly, forward * 1.02f, turn * 1.005f);
+        step(fake::pose, forward * 1.02f, turn * 1.005f);
+
+        sensor.status.x = truth.x / M_TO_IN + positionNoise(random);
+        sensor.status.y = truth.y / M_TO_IN + positionNoise(random);
+        sensor.status.yaw = lemlib::radToDeg(truth.theta) + headingNoise(random);
+        // every two seconds the GPS reads a meter off, which has to be rejected
+        if (tick % 200 == 199) sensor.status.x += 1;
+        estimator.update();
+
+        if (tick < 100) continue;
+        const lemlib::Pose estimate = estimator.getPose(true);
+        odomError += std::pow(odomOnly.distance(truth), 2);
+        positionError += std::pow(estimate.distance(truth), 2);
+        headingError += std::pow(lemlib::angleError(estimate.theta, truth.theta), 2);
+        samples++;
+    }
+    odomError = std::sqrt(odomError / samples);
+    positionError = std::sqrt(positionError / samples);
+    headingError = lemlib::radToDeg(std::sqrt(headingError / samples));
+    std::printf("gps: odometry RMS error %.2f in, estimator RMS error %.2f in and %.2f deg\n", odomError,
+                positionError, headingError);
+    CHECK(positionError < 1);
+    CHECK(positionError < odomError / 10);
+    CHECK(headingError < 2);
+    // corrections are written back to odometry
+    CHECK(fake::pose.distance(truth) < 1.5);
+}
+
+// distance in mm from a sensor at the center of the robot to the wall it faces, with the robot facing +y
+static std::int32_t wallDistance(const lemlib::Pose& truth, float angle, float halfWidth) {
+    float inches = 0;
+    if (angle == 0) inches = halfWidth - truth.y;
+    else if (angle == 90) inches = halfWidth - truth.x;
+    else if (angle == 180) inches = halfWidth + truth.y;
+    else inches = halfWidth + truth.x;
+    return std::lround(inches * 25.4f);
+}
+
+// start with odometry a few inches off, and find the pose from four distance sensors
+static void walls() {
+    std::mt19937 random(2);
+    std::normal_distribution<float> noise(0, 5);
+
+    robot::EstimatorSettings settings;
+    const lemlib::Pose truth = {10, 20, 0};
+    fake::pose = {13, 17, 0};
+    robot::PoseEstimator estimator(nullptr, settings);
+    constexpr float ANGLES[4] = {0, 90, 180, -90};
+    fake::Distance sensors[4];
+    for (int i = 0; i < 4; i++) CHECK(estimator.addWallSensor({&sensors[i], 0, 0, ANGLES[i]}));
+    CHECK(!estimator.addWallSensor({&sensors[0], 0, 0, 0}));
+    estimator.reset(5, 1);
+
+    for (int tick = 0; tick < 200; tick++) {
+        for (int i = 0; i < 4; i++)
+            sensors[i].distance = wallDistance(truth, ANGLES[i], settings.fieldHalfWidth) + noise(random);
+        // another robot 10 inches in front of the robot, which has to be rejected
+        if (tick >= 100) sensors[0].distance = 254;
+        estimator.update();
+    }
+    const lemlib::Pose estimate = estimator.getPose(true);
+    std::printf("walls: estimate %.2f, %.2f, error %.2f in\n", estimate.x, estimate.y, estimate.distance(truth));
+    CHECK(estimate.distance(truth) < 0.5);
+    CHECK(fake::pose.distance(truth) < 0.5);
+}
+
+int main() {
+    gps();
+    walls();
+    return test::finish();
+}
@@ -0,0 +1,84 @@
+// PoseHistory has to interpolate between recorded poses, forget poses older than its capacity, and never return
+// a torn or wrong pose while odometry keeps pushing from another task
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include "robot/poseHistory.hpp"
+#include "test.hpp"
+
+static void lookups() {
+    robot::PoseHistory history;
+    lemlib::Pose pose(0, 0, 0);
+    CHECK(!history.poseAt(0, pose));
+    CHECK(history.latestTime() == 0);
+
+    // 10 in/s forward and 1 rad/s, every 10ms starting at 1s
+    for (int i = 0; i < 100; i++) history.push(1000 + i * 10, {0, i * 0.1f, i * 0.01f});
+    CHECK(history.latestTime() == 1990);
+    CHECK(history.poseAt(1015, pose, true));
+    CHECK_NEAR(pose.y, 0.15, 1e-5);
+    CHECK_NEAR(pose.theta, 0.015, 1e-6);
+    CHECK(history.poseAt(1015, pose));
+    CHECK_NEAR(pose.theta, 0.015 * 180 / M_PI, 1e-4);
+    CHECK(!history.poseAt(999, pose));
+    CHECK(!history.poseAt(1991, pose));
+
+    lemlib::Pose velocity(0, 0, 0);
+    CHECK(history.velocityAt(1500, velocity, 50, true));
+    CHECK_NEAR(velocity.y, 10, 1e-3);
+    CHECK_NEAR(velocity.theta, 1, 1e-3);
+    CHECK(!history.velocityAt(1020, velocity, 50));
+
+    // the oldest poses are overwritten
+    for (int i = 100; i < 1000; i++) history.push(1000 + i * 10, {0, i * 0.1f, i * 0.01f});
+    CHECK(!history.poseAt(1500, pose));
+    CHECK(history.poseAt(1000 + 990 * 10, pose));
+    CHECK(!history.poseAt(1000 + (1000 - robot::PoseHistory::CAPACITY) * 10, pose));
+}
+
+// one task pushes poses as fast as it can while others look them up
+static void stress() {
+    robot::PoseHistory history;
+    std::atomic<bool> done {false};
+    constexpr std::uint32_t POSES = 200000;
+
+    std::thread writer([&] {
+        // x is the time, so every pose is easy to check
+        for (std::uint32_t i = 1; i <= POSES; i++) {
+            history.push(i * 10, {i * 10.0f, -(i * 10.0f), 1});
+            if (i % 64 == 0) std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    std::atomic<int> found {0};
+    std::atomic<int> wrong {0};
+    std::thread readers[2];
+    for (int r = 0; r < 2; r++) {
+        readers[r] = std::thread([&, r] {
+            std::mt19937 random(r);
+            std::uniform_int_distribution<int> age(0, robot::PoseHistory::CAPACITY * 10);
+            while (!done) {
+                const std::uint32_t latest = history.latestTime();
+                if (latest < robot::PoseHistory::CAPACITY * 10) continue;
+                const std::uint32_t time = latest - age(random);
+                lemlib::Pose pose(0, 0, 0);
+                if (!history.poseAt(time, pose, true)) continue;
+                found++;
+                if (std::fabs(pose.x - time) > 0.01f * time / 1000 || pose.y != -pose.x || pose.theta != 1) wrong++;
+            }
+        });
+    }
+    writer.join();
+    for (std::thread& reader : readers) reader.join();
+    std::printf("stress: %d lookups found, %d wrong\n", found.load(), wrong.load());
+    CHECK(found > 0);
+    CHECK(wrong == 0);
+}
+
+int main() {
+    lookups();
+    stress();
+    return test::finish();
+}
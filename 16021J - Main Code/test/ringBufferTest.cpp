@@ -0,0 +1,60 @@
+// RingBuffer has to deliver values in order, drop and count them when full, and lose nothing between two tasks
+
+#include <atomic>
+#include <thread>
+#include "robot/ringBuffer.hpp"
+#include "test.hpp"
+
+static void single() {
+    robot::RingBuffer<int, 4> buffer;
+    int value = -1;
+    CHECK(!buffer.pop(value));
+    for (int i = 0; i < 4; i++) CHECK(buffer.push(i));
+    CHECK(buffer.size() == 4);
+    CHECK(!buffer.push(4));
+    CHECK(buffer.getDropped() == 1);
+    for (int i = 0; i < 4; i++) {
+        CHECK(buffer.pop(value));
+        CHECK(value == i);
+    }
+    CHECK(!buffer.pop(value));
+    CHECK(buffer.size() == 0);
+    // wrapping around
+    for (int i = 0; i < 10; i++) {
+        CHECK(buffer.push(i));
+        CHECK(buffer.pop(value));
+        CHECK(value == i);
+    }
+}
+
+// the producer retries dropped values, so every value has to come out once, in order
+static void threads() {
+    robot::RingBuffer<std::uint32_t, 64> buffer;
+    constexpr std::uint32_t VALUES = 1000000;
+    std::thread producer([&] {
+        for (std::uint32_t i = 0; i < VALUES; i++)
+            while (!buffer.push(i)) std::this_thread::yield();
+    });
+
+    std::uint32_t expected = 0;
+    int outOfOrder = 0;
+    while (expected < VALUES) {
+        std::uint32_t value;
+        if (!buffer.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected) outOfOrder++;
+        expected = value + 1;
+    }
+    producer.join();
+    std::printf("threads: %d out of order, %u dropped and retried\n", outOfOrder, buffer.getDropped());
+    CHECK(outOfOrder == 0);
+    CHECK(buffer.size() == 0);
+}
+
+int main() {
+    single();
+    threads();
+    return test::finish();
+}
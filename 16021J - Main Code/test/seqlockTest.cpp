@@ -0,0 +1,52 @@
+// Seqlock readers have to always get a whole value, never parts of two, while a writer stores as fast as it can
+
+#include <atomic>
+#include <thread>
+#include "robot/seqlock.hpp"
+#include "test.hpp"
+
+struct Value {
+        std::uint32_t a;
+        std::uint32_t b;
+        float c;
+        std::uint32_t d;
+};
+
+int main() {
+    robot::Seqlock<Value> seqlock;
+    CHECK(seqlock.load().a == 0);
+    seqlock.store({1, 2, 3, ~1u});
+    CHECK(seqlock.load().a == 1 && seqlock.load().d == ~1u);
+
+    constexpr std::uint32_t WRITES = 2000000;
+    std::atomic<bool> done {false};
+    std::thread writer([&] {
+        for (std::uint32_t i = 2; i <= WRITES; i++) seqlock.store({i, i * 3, static_cast<float>(i % 1000), ~i});
+        done = true;
+    });
+
+    std::atomic<int> loads {0};
+    std::atomic<int> torn {0};
+    std::atomic<int> backwards {0};
+    std::thread readers[3];
+    for (std::thread& reader : readers) {
+        reader = std::thread([&] {
+            std::uint32_t previous = 0;
+            while (!done) {
+                const Value value = seqlock.load();
+                loads++;
+                if (value.b != value.a * 3 || value.c != value.a % 1000 || value.d != ~value.a) torn++;
+                if (value.a < previous) backwards++;
+                previous = value.a;
+            }
+        });
+    }
+    writer.join();
+    for (std::thread& reader : readers) reader.join();
+    std::printf("%d loads, %d torn, %d went backwards\n", loads.load(), torn.load(), backwards.load());
+    CHECK(loads > 0);
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    CHECK(seqlock.load().a == WRITES);
+    return test::finish();
+}
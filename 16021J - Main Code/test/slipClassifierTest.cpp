@@ -0,0 +1,105 @@
+// SlipClassifier has to report a hard launch, a stake ram and a side hit once each, and nothing while the robot
+// drives and turns normally
+
+#include <cmath>
+#include <random>
+#include "robot/slipClassifier.hpp"
+#include "test.hpp"
+
+constexpr float TRACK_WIDTH = 12;
+constexpr float VERTICAL_OFFSET = -1.5;
+constexpr float DT = 0.01;
+
+// a robot driven every 10ms, with the drive motors, tracking wheel and IMU it would read
+class Robot {
+    public:
+        /**
+         * @brief Move for one update
+         *
+         * @param forward how fast the robot actually moves, in in/s
+         * @param yaw how fast the robot actually turns, in deg/s, clockwise
+         * @param motorForward how fast the drive motors move, in in/s
+         * @param motorYaw how fast the drive motors turn, in deg/s
+         */
+        void step(float forward, float yaw, float motorForward, float motorYaw) {
+            const float motorTurn = motorYaw * float(M_PI) / 180 * TRACK_WIDTH / 2;
+            const float deltaLeft = (motorForward + motorTurn) * DT * (1 + noise(random));
+            const float deltaRight = (motorForward - motorTurn) * DT * (1 + noise(random));
+            // the tracking wheel also rolls when turning in place, LemLib's sign convention
+            const float deltaVertical = (forward - VERTICAL_OFFSET * yaw * float(M_PI) / 180) * DT;
+            const float deltaImu = yaw * DT + noise(random) * 0.1f;
+            now += 10;
+            classifier.update(deltaLeft, deltaRight, deltaVertical, deltaImu, DT, now);
+        }
+
+        /**
+         * @brief Drive normally for a while, the motors matching the robot apart from some scrub while turning
+         */
+        void drive(float forward, float yaw, int time) {
+            for (int t = 0; t < time; t += 10) step(forward, yaw, forward, yaw * 1.15f);
+        }
+
+        robot::SlipClassifier classifier {TRACK_WIDTH, VERTICAL_OFFSET};
+        std::uint32_t now = 0;
+    private:
+        std::mt19937 random {5};
+        std::normal_distribution<float> noise {0, 0.02};
+};
+
+// checks that a phase added the expected number of slips and collisions, and the detections expired after it
+static void expect(Robot& robot, int slips, int collisions, int& prevSlips, int& prevCollisions) {
+    CHECK(robot.classifier.getSlipCount() - prevSlips == slips);
+    CHECK(robot.classifier.getCollisionCount() - prevCollisions == collisions);
+    prevSlips = robot.classifier.getSlipCount();
+    prevCollisions = robot.classifier.getCollisionCount();
+    // settle before the next phase
+    robot.drive(0, 0, 500);
+    CHECK(!robot.classifier.isSlipping(robot.now));
+    CHECK(!robot.classifier.isColliding(robot.now));
+}
+
+int main() {
+    Robot robot;
+    int slips = 0;
+    int collisions = 0;
+
+    // normal driving: speed up at 150 in/s^2, cruise, slow down, then turn in place and drive an arc
+    for (float speed = 0; speed < 60; speed += 1.5f) robot.drive(speed, 0, 10);
+    robot.drive(60, 0, 1000);
+    for (float speed = 60; speed > 0; speed -= 1.5f) robot.drive(speed, 0, 10);
+    robot.drive(0, 400, 600);
+    robot.drive(0, -400, 600);
+    robot.drive(40, 90, 1500);
+    expect(robot, 0, 0, slips, collisions);
+
+    // hard launch: the motors spin up to 70 in/s right away, the robot only gets there at 150 in/s^2
+    for (float speed = 0; speed < 70; speed += 1.5f) robot.step(speed, 0, 70, 0);
+    robot.drive(70, 0, 200);
+    for (float speed = 70; speed > 0; speed -= 1.5f) robot.drive(speed, 0, 10);
+    expect(robot, 1, 0, slips, collisions);
+
+    // stake ram: backing into a stake at 40 in/s, the robot stops dead while the motors keep pushing, and wind
+    // down over 150ms
+    robot.drive(-40, 0, 500);
+    for (int t = 0; t < 150; t += 10) robot.step(0, 0, -40 * (1 - t / 150.0f), 0);
+    expect(robot, 1, 0, slips, collisions);
+
+    // side hit: another robot spins this one 30 degrees in 100ms while it sits still, then while it drives
+    robot.drive(0, 0, 200);
+    for (int t = 0; t < 100; t += 10) robot.step(0, 300, 0, 0);
+    expect(robot, 0, 1, slips, collisions);
+    robot.drive(30, 0, 300);
+    for (int t = 0; t < 100; t += 10) robot.step(30, -300, 30, 0);
+    robot.drive(30, 0, 300);
+    expect(robot, 0, 1, slips, collisions);
+
+    // without an IMU the drive motors are the only heading, so turning in place still reports nothing
+    robot::SlipClassifier noImu(TRACK_WIDTH, VERTICAL_OFFSET);
+    const float turn = 400 * float(M_PI) / 180 * TRACK_WIDTH / 2 * DT;
+    for (std::uint32_t now = 10; now < 1000; now += 10) {
+        noImu.update(turn, -turn, -VERTICAL_OFFSET * 4 * float(M_PI) / 180, NAN, DT, now);
+    }
+    CHECK(noImu.getSlipCount() == 0);
+    CHECK(noImu.getCollisionCount() == 0);
+    return test::finish();
+}
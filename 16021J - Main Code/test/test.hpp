@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+/**
+ * @brief Just enough of a test framework for the host tests: failed checks are printed and counted, and main
+ * returns test::finish()
+ */
+namespace test {
+inline int failures = 0;
+
+/**
+ * @brief Print the result
+ *
+ * @return int the exit code of the test, 0 if every check passed
+ */
+inline int finish() {
+    if (failures == 0) std::printf("passed\n");
+    else std::printf("%d checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
+} // namespace test
+
+#define CHECK(condition)                                                                                           \
+    do {                                                                                                           \
+        if (!(condition)) {                                                                                        \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                              \
+            test::failures++;                                                                                      \
+        }                                                                                                          \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                                                    \
+    do {                                                                                                           \
+        const double actualValue = (actual);                                                                       \
+        const double expectedValue = (expected);                                                                   \
+        if (!(std::fabs(actualValue - expectedValue) <= (tolerance))) {                                            \
+            std::printf("%s:%d: CHECK_NEAR(%s, %s) failed, %g is not within %g of %g\n", __FILE__, __LINE__,       \
+                        #actual, #expected, actualValue, static_cast<double>(tolerance), expectedValue);          \
+            test::failures++;                                                                                      \
+        }                                                                                                          \
+    } while (0)
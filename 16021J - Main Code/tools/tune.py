@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Tune the PID controllers of the robot over USB, without uploading again.
+
+Talks to robot::Tuner (include/robot/tuner.hpp) through the user serial port of the brain or controller. Close
+`pros terminal` first, only one program can have the port open.
+
+    python3 tools/tune.py --port /dev/ttyACM1 get
+    python3 tools/tune.py --port /dev/ttyACM1 set lateral 10 0 3 3
+    python3 tools/tune.py --port /dev/ttyACM1 test lateral 24 --csv lateral.csv
+    python3 tools/tune.py --port COM4 test angular 90
+    python3 tools/tune.py --port COM4 param list
+    python3 tools/tune.py --port COM4 param set intake.velocity 100
+    python3 tools/tune.py --port COM4 param save
+
+Needs pyserial (pip install pyserial).
+"""
+
+import argparse
+import sys
+import time
+
+import serial
+
+
+def cobs_decode(data):
+    """PROS wraps everything it prints in COBS frames, so the stream it came from can be told apart."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0:
+            raise ValueError("zero byte in COBS frame")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Brain:
+    def __init__(self, port):
+        self.serial = serial.Serial(port, 115200, timeout=0.1)
+        self.buffer = bytearray()
+        self.text = ""
+
+    def send(self, command):
+        self.serial.write((command + "\n").encode())
+
+    def lines(self, timeout):
+        """Yield lines printed by the program until nothing arrives for timeout seconds."""
+        last = time.monotonic()
+        while time.monotonic() - last < timeout:
+            self.buffer += self.serial.read(256)
+            while b"\0" in self.buffer:
+                frame, _, self.buffer = self.buffer.partition(b"\0")
+                try:
+                    frame = cobs_decode(frame)
+                except ValueError:
+                    continue
+                # only stdout, not stderr or kernel debug output
+                if frame[:4] == b"sout":
+                    self.text += frame[4:].decode(errors="replace")
+            while "\n" in self.text:
+                line, self.text = self.text.split("\n", 1)
+                last = time.monotonic()
+                yield line.strip()
+
+
+def replies(brain, timeout=1.0):
+    """Lines meant for the tuner, skipping telemetry and anything else the program prints."""
+    for line in brain.lines(timeout):
+        if line.split(" ", 1)[0] in ("gains", "sample", "done", "error", "param"):
+            yield line
+
+
+def summarize(samples, tolerance):
+    start_error = samples[0][1]
+    sign = 1 if start_error >= 0 else -1
+    # overshoot is how far the error went past 0, in the direction it was heading
+    overshoot = max(0.0, max(-sign * error for _, error, _, _ in samples))
+    settled = 0
+    for t, error, _, _ in samples:
+        if abs(error) > tolerance:
+            settled = t
+    print(f"start error {start_error:.2f}, final error {samples[-1][1]:.3f}, overshoot {overshoot:.3f}")
+    print(f"settled within {tolerance} at {settled} ms, peak output {max(abs(s[2]) for s in samples):.1f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", required=True, help="user serial port of the brain, like /dev/ttyACM1 or COM4")
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("get", help="print the gains of both controllers")
+    set_parser = commands.add_parser("set", help="change the gains of a controller")
+    set_parser.add_argument("controller", choices=["lateral", "angular"])
+    set_parser.add_argument("gains", type=float, nargs="+", metavar="kP kI kD [windupRange]")
+    test_parser = commands.add_parser("test", help="run a test motion and print the response")
+    test_parser.add_argument("controller", choices=["lateral", "angular"])
+    test_parser.add_argument("amount", type=float, help="inches to drive, or degrees to turn")
+    test_parser.add_argument("--timeout", type=int, default=3000, help="timeout of the motion, in ms")
+    test_parser.add_argument("--csv", help="also write the samples to this file")
+    test_parser.add_argument("--tolerance", type=float, default=1, help="error counted as settled")
+    param_parser = commands.add_parser("param", help="list, change or save the parameters on the SD card")
+    param_parser.add_argument("action", choices=["list", "set", "save", "reset"])
+    param_parser.add_argument("values", nargs="*", metavar="name value")
+    args = parser.parse_args()
+
+    brain = Brain(args.port)
+    if args.command == "get":
+        brain.send("get")
+    elif args.command == "param":
+        if (args.action == "set") != (len(args.values) == 2):
+            parser.error("param set needs a name and a value, the other actions take nothing")
+        brain.send(" ".join(["param", args.action] + args.values))
+    elif args.command == "set":
+        if not 3 <= len(args.gains) <= 4:
+            parser.error("set needs kP kI kD and optionally windupRange")
+        brain.send(f"set {args.controller} " + " ".join(f"{gain:g}" for gain in args.gains))
+    else:
+        brain.send(f"test {args.controller} {args.amount:g} {args.timeout}")
+
+    if args.command == "param":
+        replied = False
+        for line in replies(brain):
+            replied = True
+            if line.startswith("error"):
+                print(line, file=sys.stderr)
+                return 1
+            print(line)
+            # list prints every parameter, the rest answer with one line
+            if args.action != "list":
+                break
+        if not replied:
+            print("no reply, is the program running and the port right?", file=sys.stderr)
+            return 1
+        return 0
+
+    samples = []
+    wait = args.timeout / 1000 + 1 if args.command == "test" else 1
+    for line in replies(brain, wait):
+        words = line.split()
+        if words[0] == "error":
+            print(line, file=sys.stderr)
+            return 1
+        if words[0] == "gains":
+            print(line)
+            if args.command != "test" and words[1] == "angular":
+                return 0
+        elif words[0] == "sample":
+            samples.append(tuple(float(word) for word in words[1:5]))
+        elif words[0] == "done":
+            break
+    else:
+        print("no reply, is the program running and the port right?", file=sys.stderr)
+        return 1
+
+    if args.csv:
+        with open(args.csv, "w") as file:
+            file.write("time,error,output,velocity\n")
+            for sample in samples:
+                file.write(",".join(f"{value:g}" for value in sample) + "\n")
+    if samples:
+        summarize(samples, args.tolerance)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())